@@ -0,0 +1,155 @@
+// Copyright Matt Bramah-Taylor, 2025. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/Array.h"
+
+// When a slot array gives memory back after elements are removed.
+enum class EAdaSlotArrayShrinkPolicy : uint8
+{
+	// Only when Shrink is called.
+	Manual,
+
+	// Whenever a removal leaves less than half of the element allocation in use.
+	WhenHalfEmpty
+};
+
+// Container that keeps its elements packed together for iteration, while handing out slot indices that stay stable across removals.
+// Removing an element swaps the last element into its place and points that element's slot at its new position, so element order isn't
+// preserved across removals, and elements must not be removed while iterating.
+// Slots are reused as soon as they're freed, so anything holding on to a slot index should also check it still has the element it expects.
+template<typename ElementType>
+class TAdaSlotArray
+{
+public:
+	explicit TAdaSlotArray(const EAdaSlotArrayShrinkPolicy InShrinkPolicy = EAdaSlotArrayShrinkPolicy::Manual)
+		: ShrinkPolicy(InShrinkPolicy) {};
+
+	// Add an element, returning the slot it's held in.
+	template<typename... ArgsType>
+	int32 Emplace(ArgsType&&... Args)
+	{
+		const int32 SlotIndex = FreeSlots.IsEmpty() ? Slots.Add(INDEX_NONE) : FreeSlots.Pop(EAllowShrinking::No);
+		Slots[SlotIndex] = Elements.Emplace(Forward<ArgsType>(Args)...);
+		ElementSlots.Add(SlotIndex);
+
+		return SlotIndex;
+	}
+
+	inline int32 Add(const ElementType& Element) { return Emplace(Element); };
+	inline int32 Add(ElementType&& Element) { return Emplace(MoveTemp(Element)); };
+
+	// Remove the element in the given slot, moving the last element into its place.
+	void RemoveAt(const int32 SlotIndex)
+	{
+		if (!IsValidIndex(SlotIndex))
+		{
+			return;
+		}
+
+		const int32 ElementIndex = Slots[SlotIndex];
+		const int32 LastElementIndex = Elements.Num() - 1;
+		if (ElementIndex != LastElementIndex)
+		{
+			Slots[ElementSlots[LastElementIndex]] = ElementIndex;
+		}
+
+		Elements.RemoveAtSwap(ElementIndex, EAllowShrinking::No);
+		ElementSlots.RemoveAtSwap(ElementIndex, EAllowShrinking::No);
+
+		Slots[SlotIndex] = INDEX_NONE;
+		FreeSlots.Add(SlotIndex);
+
+		if (ShrinkPolicy == EAdaSlotArrayShrinkPolicy::WhenHalfEmpty && Elements.Num() < Elements.Max() / 2)
+		{
+			Shrink();
+		}
+	}
+
+	void Empty()
+	{
+		Elements.Empty();
+		ElementSlots.Empty();
+		Slots.Empty();
+		FreeSlots.Empty();
+	}
+
+	// Give back any memory we're not using, including free slots at the end of the slot table.
+	void Shrink()
+	{
+		while (!Slots.IsEmpty() && Slots.Last() == INDEX_NONE)
+		{
+			Slots.Pop(EAllowShrinking::No);
+		}
+
+		const int32 SlotCount = Slots.Num();
+		FreeSlots.RemoveAllSwap([SlotCount](const int32 SlotIndex) { return SlotIndex >= SlotCount; }, EAllowShrinking::No);
+
+		Elements.Shrink();
+		ElementSlots.Shrink();
+		Slots.Shrink();
+		FreeSlots.Shrink();
+	}
+
+	inline void SetShrinkPolicy(const EAdaSlotArrayShrinkPolicy InShrinkPolicy) { ShrinkPolicy = InShrinkPolicy; };
+
+	inline bool IsValidIndex(const int32 SlotIndex) const { return Slots.IsValidIndex(SlotIndex) && Slots[SlotIndex] != INDEX_NONE; };
+
+	inline ElementType& operator[](const int32 SlotIndex) { return Elements[Slots[SlotIndex]]; };
+	inline const ElementType& operator[](const int32 SlotIndex) const { return Elements[Slots[SlotIndex]]; };
+
+	inline int32 Num() const { return Elements.Num(); };
+	inline bool IsEmpty() const { return Elements.IsEmpty(); };
+
+	// The packed elements, for handing to APIs that want a plain array, such as reference collection.
+	// Elements must not be added or removed through it.
+	inline TArray<ElementType>& GetElements() { return Elements; };
+	inline const TArray<ElementType>& GetElements() const { return Elements; };
+
+	// Iterates over the packed elements, while also being able to say which slot each one is held in.
+	template<bool bConst>
+	class TBaseIterator
+	{
+		using ArrayType = std::conditional_t<bConst, const TAdaSlotArray, TAdaSlotArray>;
+		using ItElementType = std::conditional_t<bConst, const ElementType, ElementType>;
+
+	public:
+		explicit TBaseIterator(ArrayType& InArray) : Array(InArray) {};
+
+		inline ItElementType& operator*() const { return Array.Elements[ElementIndex]; };
+		inline ItElementType* operator->() const { return &Array.Elements[ElementIndex]; };
+		inline TBaseIterator& operator++() { ++ElementIndex; return *this; };
+		inline explicit operator bool() const { return Array.Elements.IsValidIndex(ElementIndex); };
+
+		// The slot the current element is held in.
+		inline int32 GetIndex() const { return Array.ElementSlots[ElementIndex]; };
+
+	private:
+		ArrayType& Array;
+		int32 ElementIndex = 0;
+	};
+
+	using TIterator = TBaseIterator<false>;
+	using TConstIterator = TBaseIterator<true>;
+
+	inline TIterator CreateIterator() { return TIterator(*this); };
+	inline TConstIterator CreateConstIterator() const { return TConstIterator(*this); };
+
+	// Ranged for iterates over the packed elements directly.
+	inline auto begin() { return Elements.begin(); };
+	inline auto end() { return Elements.end(); };
+	inline auto begin() const { return Elements.begin(); };
+	inline auto end() const { return Elements.end(); };
+
+private:
+	TArray<ElementType> Elements;
+
+	// The slot holding each element in Elements.
+	TArray<int32> ElementSlots;
+
+	// Where each slot's element is in Elements, or INDEX_NONE if the slot is free.
+	TArray<int32> Slots;
+	TArray<int32> FreeSlots;
+
+	EAdaSlotArrayShrinkPolicy ShrinkPolicy = EAdaSlotArrayShrinkPolicy::Manual;
+};
@@ -0,0 +1,170 @@
+// Copyright Matt Bramah-Taylor, 2025. All Rights Reserved.
+
+#pragma once
+
+#include "Algo/StableSort.h"
+#include "Containers/Array.h"
+
+// Hierarchical timing wheel. Schedules payloads against future ticks and hands back the ones that come due as time moves on, without
+// looking at anything that isn't due yet.
+// Each level is a ring of slots, and each slot on a level covers as many ticks as the whole of the level below it. Payloads are placed on
+// the lowest level that can tell their tick apart from the current one, and drop down a level each time the wheel comes round to their slot.
+// Payloads can't be cancelled, so anything that can be should be checked for still being wanted when it comes due.
+template<typename PayloadType>
+class TAdaTimingWheel
+{
+	static constexpr int32 SlotBits = 6;
+	static constexpr int32 SlotsPerLevel = 1 << SlotBits;
+	static constexpr uint64 SlotMask = SlotsPerLevel - 1;
+	static constexpr int32 LevelCount = 4;
+
+	struct FEntry
+	{
+		uint64 DueTick = 0;
+		PayloadType Payload;
+	};
+
+public:
+	explicit TAdaTimingWheel(const uint64 InCurrentTick = 0)
+		: CurrentTick(InCurrentTick) {};
+
+	// Schedule a payload for the given tick. Payloads due on or before the current tick come due on the next advance.
+	void Schedule(const uint64 DueTick, const PayloadType& Payload)
+	{
+		// Slots are only allocated once they're needed, as plenty of owners will never schedule anything.
+		if (Slots.IsEmpty())
+		{
+			Slots.SetNum(SlotsPerLevel * LevelCount);
+		}
+
+		Insert(FEntry{DueTick, Payload});
+		EntryCount++;
+	}
+
+	// Move the wheel on to the given tick, calling OnDue(DueTick, Payload) for everything due on or before it, in the order they come due.
+	// Anything scheduled from OnDue is placed relative to the tick being processed. OnDue must not reset the wheel.
+	template<typename FuncType>
+	void Advance(const uint64 ToTick, FuncType&& OnDue)
+	{
+		if (ToTick <= CurrentTick)
+		{
+			return;
+		}
+
+		// Stepping through a long stretch of ticks, such as after an owner has been asleep, costs more than placing everything again.
+		if (ToTick - CurrentTick > FMath::Max<uint64>(EntryCount, SlotsPerLevel))
+		{
+			Rebuild(ToTick, OnDue);
+			return;
+		}
+
+		while (CurrentTick < ToTick && EntryCount > 0)
+		{
+			const uint64 Tick = CurrentTick + 1;
+
+			// Bring down anything on the higher levels whose slot we've come round to. Go from the top down, so that entries can fall
+			// through more than one level on the same tick.
+			for (int32 Level = LevelCount - 1; Level > 0; Level--)
+			{
+				const uint64 LevelTickMask = (1ull << (SlotBits * Level)) - 1;
+				if ((Tick & LevelTickMask) == 0)
+				{
+					TArray<FEntry> Cascading = MoveTemp(GetSlot(Level, (Tick >> (SlotBits * Level)) & SlotMask));
+					for (FEntry& Entry : Cascading)
+					{
+						Insert(MoveTemp(Entry));
+					}
+				}
+			}
+
+			CurrentTick = Tick;
+
+			TArray<FEntry> DueEntries = MoveTemp(GetSlot(0, Tick & SlotMask));
+			EntryCount -= DueEntries.Num();
+			for (const FEntry& Entry : DueEntries)
+			{
+				OnDue(Entry.DueTick, Entry.Payload);
+			}
+		}
+
+		CurrentTick = ToTick;
+	}
+
+	// Drop everything that's scheduled and restart the wheel from the given tick.
+	void Reset(const uint64 InCurrentTick)
+	{
+		Slots.Empty();
+		EntryCount = 0;
+		CurrentTick = InCurrentTick;
+	}
+
+	inline uint64 GetCurrentTick() const { return CurrentTick; };
+
+	// Includes anything the owner has since stopped caring about, until it comes due.
+	inline int32 Num() const { return EntryCount; };
+	inline bool IsEmpty() const { return EntryCount == 0; };
+
+private:
+	inline TArray<FEntry>& GetSlot(const int32 Level, const uint64 SlotIndex) { return Slots[Level * SlotsPerLevel + static_cast<int32>(SlotIndex)]; };
+
+	void Insert(FEntry&& Entry)
+	{
+		// Entries are placed relative to the next tick to be processed, and anything overdue is processed on it.
+		const uint64 NextTick = CurrentTick + 1;
+		const uint64 PlacementTick = FMath::Max(Entry.DueTick, NextTick);
+
+		for (int32 Level = 0; Level < LevelCount; Level++)
+		{
+			// The lowest level where the placement tick is within the same rotation as the next tick, so that the wheel reaches its slot
+			// before the placement tick and no later.
+			const int32 RotationShift = SlotBits * (Level + 1);
+			if ((PlacementTick >> RotationShift) == (NextTick >> RotationShift))
+			{
+				GetSlot(Level, (PlacementTick >> (SlotBits * Level)) & SlotMask).Add(MoveTemp(Entry));
+				return;
+			}
+		}
+
+		// Beyond the top level's current rotation, so hold it in the first slot of the next one, and place it again from there.
+		GetSlot(LevelCount - 1, 0).Add(MoveTemp(Entry));
+	}
+
+	template<typename FuncType>
+	void Rebuild(const uint64 ToTick, FuncType& OnDue)
+	{
+		TArray<FEntry> DueEntries;
+		TArray<FEntry> LaterEntries;
+		LaterEntries.Reserve(EntryCount);
+		for (TArray<FEntry>& Slot : Slots)
+		{
+			for (FEntry& Entry : Slot)
+			{
+				(Entry.DueTick <= ToTick ? DueEntries : LaterEntries).Add(MoveTemp(Entry));
+			}
+
+			Slot.Reset();
+		}
+
+		Algo::StableSortBy(DueEntries, &FEntry::DueTick);
+
+		CurrentTick = ToTick;
+		EntryCount = LaterEntries.Num();
+		for (FEntry& Entry : LaterEntries)
+		{
+			Insert(MoveTemp(Entry));
+		}
+
+		for (const FEntry& Entry : DueEntries)
+		{
+			OnDue(Entry.DueTick, Entry.Payload);
+		}
+	}
+
+	// Every level's slots, one level after another.
+	TArray<TArray<FEntry>> Slots;
+
+	// The last tick that's been processed.
+	uint64 CurrentTick = 0;
+
+	int32 EntryCount = 0;
+};
@@ -2,7 +2,6 @@
 
 #include "GameplayState/AdaAttributeModifierTypes.h"
 
-#include "Curves/CurveFloat.h"
 #include "GameplayState/AdaGameplayStateComponent.h"
 #include "GameplayState/AdaStatusEffect.h"
 #include "Debug/AdaAssertionMacros.h"
@@ -166,6 +165,53 @@ bool FAdaAttributeModifier::ShouldRecalculate() const
 	return false;
 }
 
+bool FAdaAttributeModifier::NeedsTicking() const
+{
+	return IsTimeDriven() || RecalculatesValue();
+}
+
+bool FAdaAttributeModifier::RecalculatesOnGameThread() const
+{
+	return CalculationType == EAdaAttributeModCalcType::SetByEffect
+		|| (CalculationType == EAdaAttributeModCalcType::SetByDelegate && !ModifierDelegate.bThreadSafe);
+}
+
+bool FAdaAttributeModifier::RecalculatesValue() const
+{
+	// Attribute-driven modifiers are updated by their attribute changing, which wakes the component up by itself.
+	return CalculationType == EAdaAttributeModCalcType::SetByEffect
+		|| CalculationType == EAdaAttributeModCalcType::SetByDelegate
+		|| CalculationType == EAdaAttributeModCalcType::SetByData;
+}
+
+bool FAdaAttributeModifier::IsScheduled() const
+{
+	return (ApplicationType == EAdaAttributeModApplicationType::Duration || ApplicationType == EAdaAttributeModApplicationType::Periodic)
+		&& !RecalculatesValue();
+}
+
+uint64 FAdaAttributeModifier::GetNextScheduledTick() const
+{
+	if (ApplicationType == EAdaAttributeModApplicationType::Periodic)
+	{
+		if (bShouldApplyOnAdd && !bHasAppliedOnAdd)
+		{
+			return 0;
+		}
+
+		// Periodic modifiers only expire on a tick they'd otherwise apply on, so their next application is their only event.
+		return LastApplicationTick + Interval;
+	}
+
+	// Duration modifiers apply on every tick until they expire, which their attribute takes care of, so expiry is their only event.
+	return StartTick + Duration;
+}
+
+bool FAdaAttributeModifier::IsTimeDriven() const
+{
+	return ApplicationType != EAdaAttributeModApplicationType::Persistent || HasDuration();
+}
+
 bool FAdaAttributeModifier::CanApply(const uint64& CurrentTick)
 {
 	switch (ApplicationType)
@@ -229,8 +275,8 @@ float FAdaAttributeModifier::CalculateValue()
 		}
 		case EAdaAttributeModCalcType::SetByData:
 		{
-			A_ENSURE_MSG_RET(ModifierCurve.IsValid(), ModifierValue, TEXT("%hs: Invalid Curve Float asset for modifier %s."), __FUNCTION__, *ModifierCurveTag.ToString());
-			ModifierValue = ModifierCurve->GetFloatValue(CurveProgress) * CurveMultiplier;
+			A_ENSURE_MSG_RET(ModifierCurve.IsValid(), ModifierValue, TEXT("%hs: Invalid baked curve for modifier %s."), __FUNCTION__, *ModifierCurveTag.ToString());
+			ModifierValue = ModifierCurve->Sample(CurveProgress) * CurveMultiplier;
 			return ModifierValue;
 		}
 	}
@@ -256,6 +302,169 @@ void FAdaAttributeModifier::PostApply(const uint64& CurrentTick)
 	}
 }
 
+uint32 FAdaAttributeModifier::PrepareSteps(const uint64& FirstTick, const uint64& LastTick, bool& bOutExpires)
+{
+	bOutExpires = false;
+	PendingApplicationCount = 0;
+	PendingLastApplicationTick = LastApplicationTick;
+
+	if (LastTick < FirstTick)
+	{
+		return 0;
+	}
+
+	const uint64 ExpiryTick = StartTick + Duration;
+	const bool bHasDuration = HasDuration();
+
+	switch (ApplicationType)
+	{
+		case EAdaAttributeModApplicationType::Persistent:
+		{
+			PendingApplicationCount = static_cast<uint32>(LastTick - FirstTick + 1);
+			break;
+		}
+		case EAdaAttributeModApplicationType::Ticking:
+		{
+			[[fallthrough]];
+		}
+		case EAdaAttributeModApplicationType::Duration:
+		{
+			// Applies on every tick before expiry. Expiry happens on the first tick at or past the expiry tick.
+			const uint64 LastActiveTick = bHasDuration ? FMath::Min(LastTick, ExpiryTick - 1) : LastTick;
+			if ((!bHasDuration || ExpiryTick > FirstTick) && LastActiveTick >= FirstTick)
+			{
+				PendingApplicationCount = static_cast<uint32>(LastActiveTick - FirstTick + 1);
+				PendingLastApplicationTick = LastActiveTick;
+			}
+
+			if (bHasDuration && ExpiryTick <= LastTick)
+			{
+				bOutExpires = true;
+				if (bShouldApplyOnRemoval)
+				{
+					PendingApplicationCount++;
+					PendingLastApplicationTick = FMath::Max(ExpiryTick, FirstTick);
+				}
+			}
+			break;
+		}
+		case EAdaAttributeModApplicationType::Periodic:
+		{
+			if (bShouldApplyOnAdd && !bHasAppliedOnAdd)
+			{
+				bHasAppliedOnAdd = true;
+				PendingApplicationCount++;
+				PendingLastApplicationTick = FirstTick;
+			}
+
+			// Periodic modifiers apply every Interval ticks from their last application, and only expire on a tick they'd otherwise apply on.
+			const uint64 SafeInterval = FMath::Max<uint64>(Interval, 1);
+			const uint64 NextApplicationTick = FMath::Max(PendingLastApplicationTick + SafeInterval, FirstTick);
+			if (NextApplicationTick > LastTick)
+			{
+				break;
+			}
+
+			uint64 LastActiveTick = LastTick;
+			if (ExpiryTick <= LastTick)
+			{
+				const uint64 ExpiryApplicationTick = NextApplicationTick >= ExpiryTick
+					? NextApplicationTick
+					: NextApplicationTick + FMath::DivideAndRoundUp(ExpiryTick - NextApplicationTick, SafeInterval) * SafeInterval;
+
+				if (ExpiryApplicationTick <= LastTick)
+				{
+					bOutExpires = true;
+					LastActiveTick = ExpiryApplicationTick - 1;
+
+					if (bShouldApplyOnRemoval)
+					{
+						PendingApplicationCount++;
+						PendingLastApplicationTick = ExpiryApplicationTick;
+					}
+				}
+			}
+
+			if (LastActiveTick >= NextApplicationTick)
+			{
+				const uint64 IntervalsCrossed = (LastActiveTick - NextApplicationTick) / SafeInterval + 1;
+				PendingApplicationCount += static_cast<uint32>(IntervalsCrossed);
+
+				if (!bOutExpires || !bShouldApplyOnRemoval)
+				{
+					PendingLastApplicationTick = NextApplicationTick + (IntervalsCrossed - 1) * SafeInterval;
+				}
+			}
+			break;
+		}
+		default: break;
+	}
+
+	return PendingApplicationCount;
+}
+
+float FAdaAttributeModifier::CalculateAggregateValue(const uint32 ApplicationCount)
+{
+	const bool bIsMultiplier = OperationType == EAdaAttributeModOpType::Multiply;
+	if (ApplicationCount == 0)
+	{
+		return bIsMultiplier ? 1.0f : 0.0f;
+	}
+
+	if (CalculationType != EAdaAttributeModCalcType::SetByData || !ModifierCurve.IsValid())
+	{
+		return bIsMultiplier ? FMath::Pow(ModifierValue, static_cast<float>(ApplicationCount)) : ModifierValue * ApplicationCount;
+	}
+
+	// Curve modifiers move along their curve with every application, so we have to sample each one.
+	float AggregateValue = bIsMultiplier ? 1.0f : 0.0f;
+	for (uint32 Application = 0; Application < ApplicationCount; Application++)
+	{
+		ModifierValue = ModifierCurve->Sample(CurveProgress) * CurveMultiplier;
+		AggregateValue = bIsMultiplier ? AggregateValue * ModifierValue : AggregateValue + ModifierValue;
+		CurveProgress += CurveSpeed;
+	}
+
+	return AggregateValue;
+}
+
+void FAdaAttributeModifier::PostApplySteps()
+{
+	if (ApplicationType == EAdaAttributeModApplicationType::Periodic)
+	{
+		LastApplicationTick = PendingLastApplicationTick;
+	}
+
+	PendingApplicationCount = 0;
+}
+
+void FAdaAttributeModifier::RescaleTicks(const uint64 OldTick, const uint64 NewTick, const double Scale)
+{
+	StartTick = RescaleTick(StartTick, OldTick, NewTick, Scale);
+	LastApplicationTick = RescaleTick(LastApplicationTick, OldTick, NewTick, Scale);
+
+	// Anything that had a length keeps at least a single tick of it.
+	if (Duration > 0)
+	{
+		Duration = static_cast<uint32>(FMath::Clamp<int64>(FMath::RoundToInt64(Duration * Scale), 1, MAX_uint32));
+	}
+
+	if (Interval > 0)
+	{
+		Interval = static_cast<uint32>(FMath::Clamp<int64>(FMath::RoundToInt64(Interval * Scale), 1, MAX_uint32));
+	}
+}
+
+uint64 FAdaAttributeModifier::RescaleTick(const uint64 Tick, const uint64 OldTick, const uint64 NewTick, const double Scale)
+{
+	if (Tick >= OldTick)
+	{
+		return NewTick + FMath::RoundToInt64((Tick - OldTick) * Scale);
+	}
+
+	return NewTick - FMath::Min<uint64>(FMath::RoundToInt64((OldTick - Tick) * Scale), NewTick);
+}
+
 FString FAdaAttributeModifier::ToString() const
 {
 	FString OutString;
@@ -274,9 +483,9 @@ void FAdaAttributeModifier::SetModifyingAttribute(const FAdaAttribute& InAttribu
 	ModifierValue = InAttribute.GetCurrentValue();
 }
 
-void FAdaAttributeModifier::SetModifierCurve(const UCurveFloat* const InModifierCurve)
+void FAdaAttributeModifier::SetModifierCurve(const TSharedPtr<const FAdaBakedCurve>& InModifierCurve)
 {
-	A_ENSURE_RET(IsValid(InModifierCurve), void());
+	A_ENSURE_RET(InModifierCurve.IsValid(), void());
 
 	ModifierCurve = InModifierCurve;
 }
@@ -7,6 +7,127 @@
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AdaAttributeTypes)
 
+void FAdaAttributeModifierAggregate::Add(const FAdaAttributeModifier& Modifier)
+{
+	AddValue(Modifier.OperationType, Modifier.ModifierValue);
+
+	if (Modifier.ModifiesClamping())
+	{
+		ClampingDelta.X += Modifier.ClampingParams.bHasMinDelta ? Modifier.ClampingParams.MinDelta : 0.0f;
+		ClampingDelta.Y += Modifier.ClampingParams.bHasMaxDelta ? Modifier.ClampingParams.MaxDelta : 0.0f;
+	}
+
+	ModifierCount++;
+	UpdatesSinceRebuild++;
+}
+
+void FAdaAttributeModifierAggregate::Remove(const FAdaAttributeModifier& Modifier)
+{
+	A_ENSURE_RET(ModifierCount > 0, void());
+
+	// Once the last modifier is gone, we know exactly what the totals should be, so drop any error we've built up.
+	if (--ModifierCount == 0)
+	{
+		Reset();
+		return;
+	}
+
+	RemoveValue(Modifier.OperationType, Modifier.ModifierValue);
+
+	if (Modifier.ModifiesClamping())
+	{
+		ClampingDelta.X -= Modifier.ClampingParams.bHasMinDelta ? Modifier.ClampingParams.MinDelta : 0.0f;
+		ClampingDelta.Y -= Modifier.ClampingParams.bHasMaxDelta ? Modifier.ClampingParams.MaxDelta : 0.0f;
+	}
+
+	UpdatesSinceRebuild++;
+}
+
+void FAdaAttributeModifierAggregate::ChangeValue(const FAdaAttributeModifier& Modifier, const float OldValue)
+{
+	if (Modifier.ModifierValue == OldValue)
+	{
+		return;
+	}
+
+	RemoveValue(Modifier.OperationType, OldValue);
+	AddValue(Modifier.OperationType, Modifier.ModifierValue);
+
+	UpdatesSinceRebuild++;
+}
+
+void FAdaAttributeModifierAggregate::Reset()
+{
+	*this = FAdaAttributeModifierAggregate();
+}
+
+bool FAdaAttributeModifierAggregate::NeedsRebuild() const
+{
+	// The product of the non-zero multipliers can only reach zero or stop being finite by under or overflowing, which dividing won't undo.
+	return UpdatesSinceRebuild >= RebuildInterval || Multiplier == 0.0f || !FMath::IsFinite(Multiplier);
+}
+
+void FAdaAttributeModifierAggregate::AddValue(const EAdaAttributeModOpType OperationType, const float Value)
+{
+	switch (OperationType)
+	{
+		case EAdaAttributeModOpType::Additive:
+		{
+			Additive += Value;
+			break;
+		}
+		case EAdaAttributeModOpType::Multiply:
+		{
+			if (Value == 0.0f)
+			{
+				ZeroMultiplierCount++;
+			}
+			else
+			{
+				Multiplier *= Value;
+			}
+			break;
+		}
+		case EAdaAttributeModOpType::PostAdditive:
+		{
+			PostAdditive += Value;
+			break;
+		}
+		default: break;
+	}
+}
+
+void FAdaAttributeModifierAggregate::RemoveValue(const EAdaAttributeModOpType OperationType, const float Value)
+{
+	switch (OperationType)
+	{
+		case EAdaAttributeModOpType::Additive:
+		{
+			Additive -= Value;
+			break;
+		}
+		case EAdaAttributeModOpType::Multiply:
+		{
+			if (Value == 0.0f)
+			{
+				A_ENSURE(ZeroMultiplierCount > 0);
+				ZeroMultiplierCount = FMath::Max(ZeroMultiplierCount - 1, 0);
+			}
+			else
+			{
+				Multiplier /= Value;
+			}
+			break;
+		}
+		case EAdaAttributeModOpType::PostAdditive:
+		{
+			PostAdditive -= Value;
+			break;
+		}
+		default: break;
+	}
+}
+
 FAdaAttribute::FAdaAttribute(const FGameplayTag Tag, const FAdaAttributeInitParams& InitParams, const int32 NewId) :
 	AttributeTag(Tag),
 	ResetValue(InitParams.InitialValue),
@@ -0,0 +1,130 @@
+// Copyright Matt Bramah-Taylor, 2025. All Rights Reserved.
+
+#include "GameplayState/AdaBakedCurve.h"
+
+#include "Curves/RichCurve.h"
+#include "Math/VectorRegister.h"
+#include "Debug/AdaAssertionMacros.h"
+
+float FAdaBakedCurve::Bake(const FRichCurve& SourceCurve, const int32 MinResolution, const int32 MaxResolution, const float Tolerance)
+{
+	float RangeMin = 0.0f;
+	float RangeMax = 0.0f;
+	SourceCurve.GetTimeRange(RangeMin, RangeMax);
+
+	MinTime = RangeMin;
+
+	int32 Resolution = FMath::Max(MinResolution, 2);
+	const int32 ResolutionLimit = FMath::Max(MaxResolution, Resolution);
+	while (true)
+	{
+		BakeSamples(SourceCurve, RangeMax - RangeMin, Resolution);
+		MaxError = MeasureError(SourceCurve);
+
+		if (MaxError <= Tolerance || Resolution >= ResolutionLimit)
+		{
+			break;
+		}
+
+		Resolution = FMath::Min(Resolution * 2, ResolutionLimit);
+	}
+
+	return MaxError;
+}
+
+float FAdaBakedCurve::Sample(const float Time) const
+{
+	A_ENSURE_RET(Samples.Num() >= 2, 0.0f);
+
+	const float Position = GetSamplePosition(Time);
+	const int32 Index = FMath::Min(FMath::FloorToInt32(Position), Samples.Num() - 2);
+
+	return FMath::Lerp(Samples[Index], Samples[Index + 1], Position - Index);
+}
+
+void FAdaBakedCurve::SampleBatch(TArrayView<const FAdaBakedCurve* const> Curves, TArrayView<const float> Times, TArrayView<const float> Multipliers, TArrayView<float> OutValues)
+{
+	const int32 Count = OutValues.Num();
+	A_ENSURE_RET(Curves.Num() == Count && Times.Num() == Count && Multipliers.Num() == Count, void());
+
+	int32 Index = 0;
+	for (; Index + 4 <= Count; Index += 4)
+	{
+		// Curve parameters differ per lane, so they have to be gathered, but the maths on them can be done four wide.
+		alignas(16) float LaneMinTimes[4];
+		alignas(16) float LaneSampleRates[4];
+		alignas(16) float LaneLastPairs[4];
+		for (int32 Lane = 0; Lane < 4; Lane++)
+		{
+			const FAdaBakedCurve& Curve = *Curves[Index + Lane];
+			LaneMinTimes[Lane] = Curve.MinTime;
+			LaneSampleRates[Lane] = Curve.SampleRate;
+			LaneLastPairs[Lane] = static_cast<float>(Curve.Samples.Num() - 2);
+		}
+
+		const VectorRegister4Float LastPairs = VectorLoadAligned(LaneLastPairs);
+		const VectorRegister4Float Positions = VectorMin(
+			VectorMax(VectorMultiply(VectorSubtract(VectorLoad(&Times[Index]), VectorLoadAligned(LaneMinTimes)), VectorLoadAligned(LaneSampleRates)), VectorZeroFloat()),
+			VectorAdd(LastPairs, VectorOneFloat()));
+
+		// Clamping the lower sample to the last pair lets the end of the curve lerp fully onto its last sample.
+		const VectorRegister4Float LowerIndices = VectorMin(VectorFloor(Positions), LastPairs);
+		const VectorRegister4Float Alphas = VectorSubtract(Positions, LowerIndices);
+
+		alignas(16) float LaneLowerIndices[4];
+		VectorStoreAligned(LowerIndices, LaneLowerIndices);
+
+		alignas(16) float LaneLowerSamples[4];
+		alignas(16) float LaneUpperSamples[4];
+		for (int32 Lane = 0; Lane < 4; Lane++)
+		{
+			const TArray<float>& LaneSamples = Curves[Index + Lane]->Samples;
+			const int32 SampleIndex = static_cast<int32>(LaneLowerIndices[Lane]);
+			LaneLowerSamples[Lane] = LaneSamples[SampleIndex];
+			LaneUpperSamples[Lane] = LaneSamples[SampleIndex + 1];
+		}
+
+		const VectorRegister4Float LowerSamples = VectorLoadAligned(LaneLowerSamples);
+		const VectorRegister4Float Values = VectorMultiplyAdd(VectorSubtract(VectorLoadAligned(LaneUpperSamples), LowerSamples), Alphas, LowerSamples);
+		VectorStore(VectorMultiply(Values, VectorLoad(&Multipliers[Index])), &OutValues[Index]);
+	}
+
+	for (; Index < Count; Index++)
+	{
+		OutValues[Index] = Curves[Index]->Sample(Times[Index]) * Multipliers[Index];
+	}
+}
+
+void FAdaBakedCurve::BakeSamples(const FRichCurve& SourceCurve, const float Range, const int32 Resolution)
+{
+	SampleRate = Range > KINDA_SMALL_NUMBER ? (Resolution - 1) / Range : 0.0f;
+
+	Samples.SetNumUninitialized(Resolution);
+	for (int32 Index = 0; Index < Resolution; Index++)
+	{
+		const float Time = SampleRate > 0.0f ? MinTime + Index / SampleRate : MinTime;
+		Samples[Index] = SourceCurve.Eval(Time);
+	}
+}
+
+float FAdaBakedCurve::MeasureError(const FRichCurve& SourceCurve) const
+{
+	float LargestError = 0.0f;
+
+	// Keys are where the source curve turns, so they're where the baked curve is most likely to cut a corner.
+	for (const FRichCurveKey& Key : SourceCurve.GetConstRefOfKeys())
+	{
+		LargestError = FMath::Max(LargestError, FMath::Abs(Sample(Key.Time) - SourceCurve.Eval(Key.Time)));
+	}
+
+	if (SampleRate > 0.0f)
+	{
+		for (int32 Index = 0; Index < Samples.Num() - 1; Index++)
+		{
+			const float Time = MinTime + (Index + 0.5f) / SampleRate;
+			LargestError = FMath::Max(LargestError, FMath::Abs(Sample(Time) - SourceCurve.Eval(Time)));
+		}
+	}
+
+	return LargestError;
+}
@@ -54,107 +54,405 @@ void UAdaGameplayStateComponent::EndPlay(const EEndPlayReason::Type EndPlayReaso
 	StateManager->UnregisterStateComponent(this);
 }
 
+void UAdaGameplayStateComponent::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	UAdaGameplayStateComponent* const This = CastChecked<UAdaGameplayStateComponent>(InThis);
+	Collector.AddReferencedObjects(This->ActiveStatusEffects.GetElements(), This);
+
+	Super::AddReferencedObjects(InThis, Collector);
+}
+
 void UAdaGameplayStateComponent::FixedTick(const uint64& CurrentTick)
 {
 	const UWorld* const World = GetWorld();
 	A_VALIDATE_OBJ(World, void());
 
-	TArray<TPair<FAdaAttributeModifier&, uint32>> ExpiredModifiers;
-	TArray<TPair<FAdaAttributeModifier&, uint32>> PostTick_ExpiredModifiers;
+	// Slots of modifiers to remove once we're done iterating. Removing modifiers moves others around, so we can't hold on to references.
+	TArray<int32> ExpiredModifiers;
+	TArray<int32> PostTick_ExpiredModifiers;
 
 	// Maintain internal tick reference.
 	LatestTick = CurrentTick;
-	
-	for (auto It = ActiveModifiers.CreateIterator(); It; ++It)
-	{
-		int32 Index = It.GetIndex();
-		
-		FAdaAttributeModifier& Modifier = *It;
 
-		if (!Modifier.CanApply(CurrentTick))
-		{
-			continue;
-		}
+	CollectDueModifiers(CurrentTick);
 
-		// #TODO(Ada.Gameplay): Replace with index from handle?
-		FAdaAttribute* FoundAttribute = FindAttribute_Internal(Modifier.AffectedAttribute);
-		if (!FoundAttribute)
+	// Only timed and dynamic modifiers can change anything by themselves on any tick, and scheduled modifiers only on the ticks they're due,
+	// so static modifiers aren't visited at all.
+	const TArray<int32>* const TickLists[] = { &TimedModifiers, &DynamicModifiers, &DueModifiers };
+
+	// Sample every curve modifier's baked curve in one batch up front, rather than one at a time as we come to them.
+	TArray<const FAdaBakedCurve*, TInlineAllocator<16>> BatchedCurves;
+	TArray<float, TInlineAllocator<16>> BatchedCurveTimes;
+	TArray<float, TInlineAllocator<16>> BatchedCurveMultipliers;
+	for (const TArray<int32>* const TickList : TickLists)
+	{
+		for (const int32 Index : *TickList)
 		{
-			UE_LOG(LogAdaGameplayState, Error, TEXT("%hs: Invalid periodic modifier for attribute %s"), __FUNCTION__,
-			       *Modifier.AffectedAttribute.ToString());
-			ExpiredModifiers.Add({Modifier, Index});
-			continue;
+			const FAdaAttributeModifier& Modifier = ActiveModifiers[Index];
+			if (Modifier.CalculationType == EAdaAttributeModCalcType::SetByData && Modifier.ModifierCurve.IsValid())
+			{
+				BatchedCurves.Add(Modifier.ModifierCurve.Get());
+				BatchedCurveTimes.Add(Modifier.CurveProgress);
+				BatchedCurveMultipliers.Add(Modifier.CurveMultiplier);
+			}
 		}
+	}
 
-		bool bTryRecalculate = true;
-		if (Modifier.HasExpired(CurrentTick))
+	TArray<float, TInlineAllocator<16>> BatchedCurveValues;
+	BatchedCurveValues.SetNumUninitialized(BatchedCurves.Num());
+	FAdaBakedCurve::SampleBatch(BatchedCurves, BatchedCurveTimes, BatchedCurveMultipliers, BatchedCurveValues);
+	int32 NextBatchedCurveIndex = 0;
+	
+	for (const TArray<int32>* const TickList : TickLists)
+	{
+		for (const int32 Index : *TickList)
 		{
-			if (Modifier.bShouldApplyOnRemoval)
+			FAdaAttributeModifier& Modifier = ActiveModifiers[Index];
+
+			int32 BatchedCurveIndex = INDEX_NONE;
+			if (Modifier.CalculationType == EAdaAttributeModCalcType::SetByData && Modifier.ModifierCurve.IsValid())
+			{
+				BatchedCurveIndex = NextBatchedCurveIndex++;
+			}
+
+			if (!Modifier.CanApply(CurrentTick))
 			{
-				PostTick_ExpiredModifiers.Add({Modifier, Index});
+				continue;
+			}
+
+			FAdaAttribute* FoundAttribute = FindAttributeBySlot(Modifier.AffectedAttributeIndex, Modifier.AffectedAttribute);
+			if (!FoundAttribute)
+			{
+				UE_LOG(LogAdaGameplayState, Error, TEXT("%hs: Invalid periodic modifier for attribute %s"), __FUNCTION__,
+				       *Modifier.AffectedAttribute.ToString());
+				ExpiredModifiers.Add(Index);
+				continue;
+			}
+
+			bool bTryRecalculate = true;
+			if (Modifier.HasExpired(CurrentTick))
+			{
+				if (Modifier.bShouldApplyOnRemoval)
+				{
+					PostTick_ExpiredModifiers.Add(Index);
+				}
+				else
+				{
+					ExpiredModifiers.Add(Index);
+					bTryRecalculate = false;
+				}
+			}
+
+			// Update dynamic modifiers.
+			bool bValueChanged = false;
+			if (bTryRecalculate && Modifier.ShouldRecalculate())
+			{
+				const float OldValue = Modifier.GetValue();
+				float NewValue = 0.0f;
+				if (BatchedCurveIndex != INDEX_NONE)
+				{
+					NewValue = BatchedCurveValues[BatchedCurveIndex];
+					Modifier.SetValue(NewValue);
+				}
+				else
+				{
+					NewValue = Modifier.CalculateValue();
+				}
+
+				if (Modifier.IsAggregated())
+				{
+					FoundAttribute->CurrentAggregate.ChangeValue(Modifier, OldValue);
+				}
+
+				bValueChanged = !FMath::IsNearlyEqual(OldValue, NewValue);
+			}
+
+			// Aggregated modifiers aren't visited when their attribute is recalculated, so they're moved along here instead.
+			if (Modifier.IsAggregated())
+			{
+				Modifier.PostApply(CurrentTick);
+			}
+
+			bool bMarkAttributeDirty = false;
+			if (Modifier.ApplicationType == EAdaAttributeModApplicationType::Persistent)
+			{
+				bMarkAttributeDirty = bValueChanged;
 			}
 			else
 			{
-				ExpiredModifiers.Add({Modifier, Index});
-				bTryRecalculate = false;
+				bMarkAttributeDirty = true;
+			}
+
+			if (bMarkAttributeDirty)
+			{
+				FAdaAttribute& Attribute = *FoundAttribute;
+				Attribute.bIsDirty = true;
 			}
 		}
+	}
 
-		// Update dynamic modifiers.
-		bool bValueChanged = false;
-		if (bTryRecalculate && Modifier.ShouldRecalculate())
-		{
-			const float OldValue = Modifier.GetValue();
-			const float NewValue = Modifier.CalculateValue();
+	for (const int32 Index : ExpiredModifiers)
+	{
+		RemoveModifierByIndex(Index);
+	}
 
-			bValueChanged = !FMath::IsNearlyEqual(OldValue, NewValue);
+	// Update attributes.
+	for (auto It = Attributes.CreateIterator(); It; ++It)
+	{
+		FAdaAttribute& Attribute = *It;
+		if (Attribute.bIsDirty || Attribute.DurationModifierCount > 0)
+		{
+			RecalculateAttribute(Attribute, CurrentTick);
 		}
+	}
+
+	for (const int32 Index : PostTick_ExpiredModifiers)
+	{
+		RemoveModifierByIndex(Index);
+	}
+
+	// Put the scheduled modifiers that are still around back on the schedule for their next event.
+	for (const int32 Index : DueModifiers)
+	{
+		ScheduleModifier(Index);
+	}
+
+	bReadyToSleep = CanSleep();
+	
+	BroadcastPostFixedTick();
+}
+
+void UAdaGameplayStateComponent::FixedTick(const uint64& CurrentTick, const uint32 StepCount)
+{
+	if (StepCount <= 1)
+	{
+		FixedTick(CurrentTick);
+		return;
+	}
+
+	const UWorld* const World = GetWorld();
+	A_VALIDATE_OBJ(World, void());
+
+	TArray<int32> ExpiredModifiers;
+	TArray<int32> PostTick_ExpiredModifiers;
 
-		bool bMarkAttributeDirty = false;
-		if (Modifier.ApplicationType == EAdaAttributeModApplicationType::Persistent)
+	// The inclusive range of ticks we're catching up on.
+	const uint64 FirstTick = CurrentTick >= StepCount ? CurrentTick - StepCount + 1 : 0;
+
+	// Maintain internal tick reference.
+	LatestTick = CurrentTick;
+
+	// Scheduled modifiers with an event anywhere in the range work out everything they do over it in closed form, like the rest.
+	CollectDueModifiers(CurrentTick);
+
+	const TArray<int32>* const TickLists[] = { &TimedModifiers, &DynamicModifiers, &DueModifiers };
+
+	for (const TArray<int32>* const TickList : TickLists)
+	{
+		for (const int32 Index : *TickList)
 		{
-			bMarkAttributeDirty = bValueChanged;
+			FAdaAttributeModifier& Modifier = ActiveModifiers[Index];
+
+			bool bExpires = false;
+			const uint32 ApplicationCount = Modifier.PrepareSteps(FirstTick, CurrentTick, bExpires);
+			if (ApplicationCount == 0 && !bExpires)
+			{
+				continue;
+			}
+
+			FAdaAttribute* FoundAttribute = FindAttributeBySlot(Modifier.AffectedAttributeIndex, Modifier.AffectedAttribute);
+			if (!FoundAttribute)
+			{
+				UE_LOG(LogAdaGameplayState, Error, TEXT("%hs: Invalid periodic modifier for attribute %s"), __FUNCTION__,
+				       *Modifier.AffectedAttribute.ToString());
+				ExpiredModifiers.Add(Index);
+				continue;
+			}
+
+			bool bTryRecalculate = true;
+			if (bExpires)
+			{
+				if (Modifier.bShouldApplyOnRemoval)
+				{
+					PostTick_ExpiredModifiers.Add(Index);
+				}
+				else
+				{
+					ExpiredModifiers.Add(Index);
+					bTryRecalculate = false;
+				}
+			}
+
+			// Update dynamic modifiers. Curve modifiers on the base value are sampled per application when the attribute is recalculated,
+			// but aggregated ones aren't visited then, so they move along their curve for each application here, ending on the latest sample.
+			bool bValueChanged = false;
+			if (bTryRecalculate && Modifier.ShouldRecalculate())
+			{
+				const float OldValue = Modifier.GetValue();
+				if (Modifier.IsAggregated() && Modifier.CalculationType == EAdaAttributeModCalcType::SetByData)
+				{
+					Modifier.CalculateAggregateValue(FMath::Max<uint32>(ApplicationCount, 1));
+				}
+				else
+				{
+					Modifier.CalculateValue();
+				}
+
+				const float NewValue = Modifier.GetValue();
+				if (Modifier.IsAggregated())
+				{
+					FoundAttribute->CurrentAggregate.ChangeValue(Modifier, OldValue);
+				}
+
+				bValueChanged = !FMath::IsNearlyEqual(OldValue, NewValue);
+			}
+
+			if (Modifier.IsAggregated())
+			{
+				Modifier.PostApplySteps();
+			}
+
+			bool bMarkAttributeDirty = false;
+			if (Modifier.ApplicationType == EAdaAttributeModApplicationType::Persistent)
+			{
+				bMarkAttributeDirty = bValueChanged;
+			}
+			else
+			{
+				bMarkAttributeDirty = true;
+			}
+
+			if (bMarkAttributeDirty)
+			{
+				FAdaAttribute& Attribute = *FoundAttribute;
+				Attribute.bIsDirty = true;
+
+				// Attributes are recalculated on every tick one of their modifiers touches them, which drives target decay.
+				Attribute.PendingStepCount = FMath::Max(Attribute.PendingStepCount, FMath::Max<uint32>(ApplicationCount, 1));
+			}
 		}
-		else
+	}
+
+	for (const int32 Index : ExpiredModifiers)
+	{
+		RemoveModifierByIndex(Index);
+	}
+
+	// Update attributes.
+	for (auto It = Attributes.CreateIterator(); It; ++It)
+	{
+		FAdaAttribute& Attribute = *It;
+		if (Attribute.DurationModifierCount > 0)
 		{
-			bMarkAttributeDirty = true;
+			// Duration modifiers that aren't expiring apply on every tick we're catching up on.
+			Attribute.bIsDirty = true;
+			Attribute.PendingStepCount = FMath::Max(Attribute.PendingStepCount, StepCount);
 		}
 
-		if (bMarkAttributeDirty)
+		if (Attribute.bIsDirty)
 		{
-			FAdaAttribute& Attribute = *FoundAttribute;
-			Attribute.bIsDirty = true;
+			RecalculateAttribute(Attribute, CurrentTick, StepCount);
 		}
 	}
 
-	for (auto& [ExpiredModifier, Index] : ExpiredModifiers)
+	for (const int32 Index : PostTick_ExpiredModifiers)
 	{
-		RemoveModifier_Internal(ExpiredModifier, Index);
+		RemoveModifierByIndex(Index);
 	}
 
-	// Update attributes.
-	for (auto It = Attributes.CreateIterator(); It; ++It)
+	for (const int32 Index : DueModifiers)
+	{
+		ScheduleModifier(Index);
+	}
+
+	bReadyToSleep = CanSleep();
+
+	BroadcastPostFixedTick();
+}
+
+int32 UAdaGameplayStateComponent::GetTickWorkEstimate() const
+{
+	int32 DirtyAttributeCount = 0;
+	for (const FAdaAttribute& Attribute : Attributes)
+	{
+		DirtyAttributeCount += Attribute.bIsDirty ? 1 : 0;
+	}
+
+	return 1 + TimedModifiers.Num() + DynamicModifiers.Num() + DirtyAttributeCount;
+}
+
+bool UAdaGameplayStateComponent::CanSleep() const
+{
+	for (const FAdaAttribute& Attribute : Attributes)
 	{
-		FAdaAttribute& Attribute = *It;
 		if (Attribute.bIsDirty)
 		{
-			RecalculateAttribute(Attribute, CurrentTick);
+			return false;
 		}
 	}
 
-	for (auto& [ExpiredModifier, Index] : PostTick_ExpiredModifiers)
+	return TimedModifiers.IsEmpty() && DynamicModifiers.IsEmpty() && ScheduledModifierCount == 0;
+}
+
+void UAdaGameplayStateComponent::WakeUp()
+{
+	bReadyToSleep = false;
+
+	// Only the manager puts components to sleep, on the game thread, so there's nothing to do while we're being ticked.
+	if (!bIsAsleep)
 	{
-		RemoveModifier_Internal(ExpiredModifier, Index);
+		return;
 	}
-	
-	if (OnPostFixedTick.IsBound())
+
+	const UWorld* const World = GetWorld();
+	A_ENSURE_RET(IsValid(World), void());
+
+	const AAdaGameState* const GameState = World->GetGameState<AAdaGameState>();
+	A_ENSURE_RET(IsValid(GameState), void());
+
+	UAdaGameplayStateManager* StateManager = GameState->GetGameplayStateManager();
+	A_ENSURE_RET(IsValid(StateManager), void());
+
+	StateManager->WakeStateComponent(this);
+}
+
+void UAdaGameplayStateComponent::CatchUpToBucket()
+{
+	const UWorld* const World = GetWorld();
+	A_ENSURE_RET(IsValid(World), void());
+
+	const AAdaGameState* const GameState = World->GetGameState<AAdaGameState>();
+	A_ENSURE_RET(IsValid(GameState), void());
+
+	UAdaGameplayStateManager* StateManager = GameState->GetGameplayStateManager();
+	A_ENSURE_RET(IsValid(StateManager), void());
+
+	StateManager->CatchUpStateComponent(this);
+}
+
+void UAdaGameplayStateComponent::RescaleTicks(const uint64 OldTick, const uint64 NewTick, const double Scale)
+{
+	for (FAdaAttributeModifier& Modifier : ActiveModifiers)
+	{
+		Modifier.RescaleTicks(OldTick, NewTick, Scale);
+	}
+
+	LatestTick = FAdaAttributeModifier::RescaleTick(LatestTick, OldTick, NewTick, Scale);
+
+	// Everything on the schedule was placed on the old timeline, so place it all again.
+	ModifierSchedule.Reset(LatestTick);
+	ScheduledModifierCount = 0;
+	for (auto It = ActiveModifiers.CreateIterator(); It; ++It)
 	{
-		OnPostFixedTick.Broadcast();
+		It->bIsOnSchedule = false;
+		ScheduleModifier(It.GetIndex());
 	}
 }
 
 FAdaAttributeHandle UAdaGameplayStateComponent::AddAttribute(const FGameplayTag AttributeTag, const FAdaAttributeInitParams& InitParams)
 {
+	WaitForPipelinedTick();
+
 	if (FindAttribute_Internal(AttributeTag))
 	{
 		UE_LOG(LogAdaGameplayState, Error, TEXT("%hs: Already added attribute %s to component %s"), __FUNCTION__, *AttributeTag.ToString(), *GetNameSafe(this));
@@ -176,6 +474,7 @@ FAdaAttributeHandle UAdaGameplayStateComponent::AddAttribute(const FGameplayTag
 
 	const int32 Identifier = GetNextAttributeId();
 	const int32 Index = Attributes.Add(FAdaAttribute(AttributeTag, ModifiedInitParams, Identifier));
+	AttributeIndices.Add(AttributeTag, Index);
 
 	if (OnAttributeAdded.IsBound())
 	{
@@ -187,6 +486,8 @@ FAdaAttributeHandle UAdaGameplayStateComponent::AddAttribute(const FGameplayTag
 
 void UAdaGameplayStateComponent::RemoveAttribute(const FAdaAttributeHandle& AttributeHandle)
 {
+	WaitForPipelinedTick();
+
 	const FAdaAttribute* FoundAttribute = AttributeHandle.Get();
 	if (!FoundAttribute)
 	{
@@ -194,7 +495,10 @@ void UAdaGameplayStateComponent::RemoveAttribute(const FAdaAttributeHandle& Attr
 		return;
 	}
 
-	for (auto& [DependentAttributeTag, Index]: FoundAttribute->AttributeDependencies)
+	// Removing these modifiers removes them from the attribute's dependencies, so take a copy of them first.
+	TArray<int32> DependentModifierIndices;
+	FoundAttribute->AttributeDependencies.GenerateValueArray(DependentModifierIndices);
+	for (const int32 Index : DependentModifierIndices)
 	{
 		RemoveModifierByIndex(Index);
 	}
@@ -204,20 +508,18 @@ void UAdaGameplayStateComponent::RemoveAttribute(const FAdaAttributeHandle& Attr
 		OnAttributeRemoved.Broadcast(AttributeHandle.AttributeTag);
 	}
 	
+	AttributeIndices.Remove(AttributeHandle.AttributeTag);
 	Attributes.RemoveAt(AttributeHandle.Index);
 }
 
 FAdaAttributeHandle UAdaGameplayStateComponent::FindAttribute(const FGameplayTag AttributeTag) const
 {
-	for (auto It = Attributes.CreateConstIterator(); It; ++It)
+	WaitForPipelinedTick();
+
+	const int32 Index = FindAttributeIndex(AttributeTag);
+	if (Index != INDEX_NONE)
 	{
-		const int32 Index = It.GetIndex();
-		const FAdaAttribute& Attribute = *It;
-		
-		if (Attribute.AttributeTag == AttributeTag)
-		{
-			return FAdaAttributeHandle(this, AttributeTag, Index, Attribute.Identifier);
-		}
+		return FAdaAttributeHandle(this, AttributeTag, Index, Attributes[Index].Identifier);
 	}
 
 	UE_LOG(LogAdaGameplayState, Error, TEXT("%hs: Unable to find attribute %s on component %s"), __FUNCTION__, *AttributeTag.ToString(), *GetNameSafe(this));
@@ -242,6 +544,10 @@ float UAdaGameplayStateComponent::GetAttributeValue(const FGameplayTag Attribute
 
 void UAdaGameplayStateComponent::SetAttributeTargetValue(const FGameplayTag AttributeTag, const float Value)
 {
+	WaitForPipelinedTick();
+
+	WakeUp();
+
 	if (FAdaAttribute* FoundAttribute = FindAttribute_Internal(AttributeTag))
 	{
 		A_ENSURE_MSG_RET(FoundAttribute->bUsesTargetValue, void(), TEXT("Tried to use target value on attribute %s, which is not configured for target values."), *AttributeTag.ToString());
@@ -288,7 +594,31 @@ FAdaOnThresholdValueHit* UAdaGameplayStateComponent::GetThresholdDelegateForAttr
 
 FAdaAttributeModifierHandle UAdaGameplayStateComponent::ModifyAttribute(const FGameplayTag AttributeTag, const FAdaAttributeModifierSpec& ModifierToApply)
 {
+	TArray<FString> Errors;
+	if (!UAdaAttributeFunctionLibrary::IsModifierValid(ModifierToApply, Errors))
+	{
+		UE_LOG(LogAdaGameplayState, Error, TEXT("%hs: Invalid modifier for attribute %s:"), __FUNCTION__, *AttributeTag.ToString());
+		for (const FString& ErrorString : Errors)
+		{
+			UE_LOG(LogAdaGameplayState, Error, TEXT("%hs: %s"), __FUNCTION__, *ErrorString);
+		}
+		
+		return FAdaAttributeModifierHandle();
+	}
+
+	return ModifyAttribute_Internal(AttributeTag, ModifierToApply, nullptr);
+}
+
+FAdaAttributeModifierHandle UAdaGameplayStateComponent::ModifyAttribute_Internal(const FGameplayTag AttributeTag, const FAdaAttributeModifierSpec& ModifierToApply, const TSharedPtr<const FAdaBakedCurve>& ModifierCurve)
+{
+	WaitForPipelinedTick();
+
 	FAdaAttributeModifierHandle OutHandle = FAdaAttributeModifierHandle();
+
+	// Wake up and catch up first, so that the new modifier starts from the current tick rather than the tick we went to sleep on,
+	// or the last tick our tier let us have.
+	WakeUp();
+	CatchUpToBucket();
 	
 	FAdaAttribute* FoundAttribute = FindAttribute_Internal(AttributeTag);
 	if (!FoundAttribute)
@@ -303,18 +633,6 @@ FAdaAttributeModifierHandle UAdaGameplayStateComponent::ModifyAttribute(const FG
 		return OutHandle;
 	}
 
-	TArray<FString> Errors;
-	if (!UAdaAttributeFunctionLibrary::IsModifierValid(ModifierToApply, Errors))
-	{
-		UE_LOG(LogAdaGameplayState, Error, TEXT("%hs: Invalid modifier for attribute %s:"), __FUNCTION__, *AttributeTag.ToString());
-		for (const FString& ErrorString : Errors)
-		{
-			UE_LOG(LogAdaGameplayState, Error, TEXT("%hs: %s"), __FUNCTION__, *ErrorString);
-		}
-		
-		return OutHandle;
-	}
-
 	FAdaAttribute& Attribute = *FoundAttribute;
 
 	// Perform initial modification, forcing refresh of the attribute.
@@ -332,7 +650,22 @@ FAdaAttributeModifierHandle UAdaGameplayStateComponent::ModifyAttribute(const FG
 			A_ENSURE(OutIndex != INDEX_NONE);
 			OutHandle = FAdaAttributeModifierHandle(this, OutIndex, ModifierId);
 
+			AddToTickList(OutIndex);
+
 			InAttribute.ActiveModifiers.Add(OutHandle);
+			if (ModifierRef.ApplicationType == EAdaAttributeModApplicationType::Duration)
+			{
+				InAttribute.DurationModifierCount++;
+			}
+
+			if (ModifierRef.IsAggregated())
+			{
+				InAttribute.CurrentAggregate.Add(ModifierRef);
+			}
+			else if (ModifierRef.bAffectsBase)
+			{
+				InAttribute.BaseModifiers.Add(OutHandle);
+			}
 
 			return OutIndex;
 		};
@@ -340,6 +673,7 @@ FAdaAttributeModifierHandle UAdaGameplayStateComponent::ModifyAttribute(const FG
 		const int32 ModifierId = GetNextModifierId();
 		// Create the modifier, but don't cache it yet as we may have extra setup to do first.
 		FAdaAttributeModifier* Modifier = new FAdaAttributeModifier(AttributeTag, ModifierToApply, LatestTick, ModifierId);
+		Modifier->AffectedAttributeIndex = FindAttributeIndex(AttributeTag);
 		
 		int32 OutIndex = INDEX_NONE;
 		if (Modifier->CalculationType == EAdaAttributeModCalcType::SetByAttribute)
@@ -358,6 +692,7 @@ FAdaAttributeModifierHandle UAdaGameplayStateComponent::ModifyAttribute(const FG
 			}
 			
 			Modifier->SetModifyingAttribute(*ModifyingAttribute);
+			Modifier->ModifyingAttributeIndex = FindAttributeIndex(ModifierToApply.ModifyingAttribute);
 			
 			// Cache the modifier.
 			OutIndex = CacheModifier(*Modifier, Attribute, OutHandle, ModifierId);
@@ -366,16 +701,24 @@ FAdaAttributeModifierHandle UAdaGameplayStateComponent::ModifyAttribute(const FG
 		}
 		else if (Modifier->CalculationType == EAdaAttributeModCalcType::SetByData)
 		{
-			const UWorld* const World = GetWorld();
-			A_ENSURE_RET(IsValid(World), OutHandle);
+			if (ModifierCurve.IsValid())
+			{
+				Modifier->SetModifierCurve(ModifierCurve);
+			}
+			else
+			{
+				const UWorld* const World = GetWorld();
+				A_ENSURE_RET(IsValid(World), OutHandle);
 
-			const AAdaGameState* const GameState = World->GetGameState<AAdaGameState>();
-			A_ENSURE_RET(IsValid(GameState), OutHandle);
+				const AAdaGameState* const GameState = World->GetGameState<AAdaGameState>();
+				A_ENSURE_RET(IsValid(GameState), OutHandle);
+
+				UAdaGameplayStateManager* StateManager = GameState->GetGameplayStateManager();
+				A_ENSURE_RET(IsValid(StateManager), OutHandle);
+
+				Modifier->SetModifierCurve(StateManager->GetBakedCurveForModifier(ModifierToApply.ModifierCurveTag));
+			}
 
-			UAdaGameplayStateManager* StateManager = GameState->GetGameplayStateManager();
-			A_ENSURE_RET(IsValid(StateManager), OutHandle);
-			
-			Modifier->SetModifierCurve(StateManager->GetCurveForModifier(ModifierToApply.ModifierCurveTag));
 			Modifier->CalculateValue();
 
 			// Cache the modifier.
@@ -407,6 +750,8 @@ FAdaAttributeModifierHandle UAdaGameplayStateComponent::ModifyAttribute(const FG
 
 bool UAdaGameplayStateComponent::RemoveModifier(FAdaAttributeModifierHandle& ModifierHandle)
 {
+	WaitForPipelinedTick();
+
 	FAdaAttributeModifier* Modifier = FindModifierByIndex(ModifierHandle.Index);
 	if (!Modifier)
 	{
@@ -428,57 +773,97 @@ bool UAdaGameplayStateComponent::RemoveModifier(FAdaAttributeModifierHandle& Mod
 
 FAdaStatusEffectHandle UAdaGameplayStateComponent::AddStatusEffect(const FGameplayTag StatusEffectTag)
 {
+	WaitForPipelinedTick();
+
 	if (!StatusEffectTag.IsValid())
 	{
 		return FAdaStatusEffectHandle();
 	}
 
+	WakeUp();
+
 	const UWorld* const World = GetWorld();
 	A_ENSURE_RET(IsValid(World), FAdaStatusEffectHandle());
 
 	const AAdaGameState* const GameState = World->GetGameState<AAdaGameState>();
 	A_ENSURE_RET(IsValid(GameState), FAdaStatusEffectHandle());
 
-	const UAdaGameplayStateManager* const StateManager = GameState->GetGameplayStateManager();
+	UAdaGameplayStateManager* const StateManager = GameState->GetGameplayStateManager();
 	A_ENSURE_RET(IsValid(StateManager), FAdaStatusEffectHandle());
 
-	const UAdaStatusEffectDefinition* const StatusEffectDef = StateManager->GetStatusEffectDefinition(StatusEffectTag);
-	A_ENSURE_RET(IsValid(StatusEffectDef), FAdaStatusEffectHandle());
+	if (!StateManager->IsStatusEffectLoaded(StatusEffectTag))
+	{
+		UE_LOG(LogAdaGameplayState, Warning, TEXT("%hs: Status effect %s isn't loaded yet, so can't be applied until it's been streamed in."), __FUNCTION__, *StatusEffectTag.ToString());
+		StateManager->RequestStatusEffectLoad(StatusEffectTag);
+		return FAdaStatusEffectHandle();
+	}
+
+	TSharedPtr<const FAdaCompiledStatusEffect> CompiledEffect = StateManager->GetCompiledStatusEffect(StatusEffectTag);
+	A_ENSURE_RET(CompiledEffect.IsValid(), FAdaStatusEffectHandle());
 
 	// Prevent activation if we already have an active instance of this effect and don't allow for stacking.
-	if (ActiveStatusEffectTags.HasMatchingGameplayTag(StatusEffectTag) && !StatusEffectDef->bCanStack)
+	if (!CompiledEffect->bCanStack && ActiveStatusEffectTags.HasMatchingGameplayTag(StatusEffectTag))
 	{
 		return FAdaStatusEffectHandle();
 	}
 
 	// Check we don't have any tags that would block this effect.
-	if (ActiveStates.HasAnyMatchingGameplayTags(StatusEffectDef->BlockingTags))
+	if (ActiveStates.HasAnyMatchingGameplayTags(CompiledEffect->BlockingTags))
 	{
 		return FAdaStatusEffectHandle();
 	}
 
 	// Check we have all of the tags that this effect requires for activation.
-	if (!ActiveStates.HasAllMatchingGameplayTags(StatusEffectDef->EnablingTags))
+	if (!ActiveStates.HasAllMatchingGameplayTags(CompiledEffect->EnablingTags))
 	{
 		return FAdaStatusEffectHandle();
 	}
 
-	const UClass* Implementation = IsValid(StatusEffectDef->Implementation) ? StatusEffectDef->Implementation.Get() : UAdaStatusEffect::StaticClass();
-	TStrongObjectPtr<UAdaStatusEffect> NewStatusEffect = TStrongObjectPtr(NewObject<UAdaStatusEffect>(this, Implementation));
-	A_ENSURE_RET(IsValid(NewStatusEffect.Get()), FAdaStatusEffectHandle());
+	// Cancel any relevant effects before adding this one, so that it can't cancel itself.
+	if (CompiledEffect->bCancelsEffects)
+	{
+		TArray<int32> IndicesToRemove;
+		for (auto It = ActiveStatusEffects.CreateConstIterator(); It; ++It)
+		{
+			int32 Index = It.GetIndex();
+			const TObjectPtr<UAdaStatusEffect> StatusEffectPtr = *It;
+			A_ENSURE_RET(StatusEffectPtr, FAdaStatusEffectHandle());
+			
+			if (CompiledEffect->EffectsToCancel.HasTag(StatusEffectPtr->EffectTag))
+			{
+				IndicesToRemove.Add(Index);
+			}
+			else if (CompiledEffect->EffectTypesToCancel.HasAny(StatusEffectPtr->TagCategories))
+			{
+				IndicesToRemove.Add(Index);
+			}
+		}
+
+		// Remove them properly, so that their modifiers and state tags go with them.
+		for (const int32 Index : IndicesToRemove)
+		{
+			RemoveStatusEffect_Internal(Index);
+		}
+	}
+
+	UAdaStatusEffect* const NewStatusEffect = NewObject<UAdaStatusEffect>(this, CompiledEffect->Implementation);
+	A_ENSURE_RET(IsValid(NewStatusEffect), FAdaStatusEffectHandle());
 
 	NewStatusEffect->EffectTag = StatusEffectTag;
 	NewStatusEffect->EffectId = GetNextStatusEffectId();
+	NewStatusEffect->TagCategories = CompiledEffect->TagCategories;
+	NewStatusEffect->CompiledDefinition = CompiledEffect;
 	
-	for (const auto& [AttributeTag, ModifierSpecRef] : StatusEffectDef->Modifiers)
+	for (const FAdaCompiledStatusEffectModifier& CompiledModifier : CompiledEffect->Modifiers)
 	{
-		// Copy the modifier spec from the effect definition.
+		// Copy the modifier spec from the compiled effect.
 		// We're going to modify the spec itself, so we don't want to propagate those changes into the
-		// effect definition by mistake.
-		FAdaAttributeModifierSpec EffectModifierSpec = ModifierSpecRef;
-		EffectModifierSpec.SetEffectData(NewStatusEffect.Get());
+		// compiled effect by mistake.
+		FAdaAttributeModifierSpec EffectModifierSpec = CompiledModifier.ModifierSpec;
+		EffectModifierSpec.SetEffectData(NewStatusEffect);
 
-		FAdaAttributeModifierHandle ModifierHandle = ModifyAttribute(AttributeTag, EffectModifierSpec);
+		// Compiled modifiers were validated when they were compiled, and binding the effect's data is all it takes to make them valid at runtime.
+		FAdaAttributeModifierHandle ModifierHandle = ModifyAttribute_Internal(CompiledModifier.AttributeTag, EffectModifierSpec, CompiledModifier.ModifierCurve);
 		if (EffectModifierSpec.ApplicationType != EAdaAttributeModApplicationType::Instant)
 		{
 			NewStatusEffect->ActiveModifierHandles.Add(ModifierHandle);
@@ -488,50 +873,65 @@ FAdaStatusEffectHandle UAdaGameplayStateComponent::AddStatusEffect(const FGamepl
 	FAdaStatusEffectHandle NewStatusEffectHandle = FAdaStatusEffectHandle();
 	NewStatusEffectHandle.OwningStateComponentWeak = this;
 	NewStatusEffectHandle.Identifier = NewStatusEffect->EffectId;
-	NewStatusEffectHandle.Index = ActiveStatusEffects.Add(MoveTemp(NewStatusEffect));
+	NewStatusEffectHandle.Index = ActiveStatusEffects.Add(NewStatusEffect);
 
 	// Add a new instance of the effect to our explicit tag tracking container.
 	ActiveStatusEffectTags.UpdateTagCount(StatusEffectTag, 1);
 
 	// Update the state on this component with the state from the effect.
-	ActiveStates.UpdateTagCount(StatusEffectDef->StateTagsToAdd, 1);
-	
-	// Cancel any relevant effects
-	if (!StatusEffectDef->EffectsToCancel.IsEmpty() || !StatusEffectDef->EffectTypesToCancel.IsEmpty())
+	ActiveStates.UpdateTagCount(CompiledEffect->StateTagsToAdd, 1);
+
+	return NewStatusEffectHandle;
+}
+
+void UAdaGameplayStateComponent::AddStatusEffectWhenLoaded(const FGameplayTag StatusEffectTag, TUniqueFunction<void(const FAdaStatusEffectHandle&)>&& OnAdded)
+{
+	const UWorld* const World = GetWorld();
+	A_ENSURE_RET(IsValid(World), void());
+
+	const AAdaGameState* const GameState = World->GetGameState<AAdaGameState>();
+	A_ENSURE_RET(IsValid(GameState), void());
+
+	UAdaGameplayStateManager* const StateManager = GameState->GetGameplayStateManager();
+	A_ENSURE_RET(IsValid(StateManager), void());
+
+	StateManager->RequestStatusEffectLoad(StatusEffectTag, [WeakThis = TWeakObjectPtr<UAdaGameplayStateComponent>(this), StatusEffectTag, OnAdded = MoveTemp(OnAdded)](const bool bLoaded)
 	{
-		TArray<int32> IndicesToRemove;
-		for (auto It = ActiveStatusEffects.CreateConstIterator(); It; ++It)
+		FAdaStatusEffectHandle NewStatusEffectHandle = FAdaStatusEffectHandle();
+		if (bLoaded && WeakThis.IsValid())
 		{
-			int32 Index = It.GetIndex();
-			const TStrongObjectPtr<UAdaStatusEffect> StatusEffectPtr = *It;
-			A_ENSURE_RET(StatusEffectPtr, FAdaStatusEffectHandle());
-			
-			if (StatusEffectDef->EffectsToCancel.HasAny(StatusEffectPtr->EffectTag.GetSingleTagContainer()))
-			{
-				IndicesToRemove.Add(Index);
-			}
-			else if (StatusEffectDef->EffectTypesToCancel.HasAny(StatusEffectPtr->TagCategories))
-			{
-				IndicesToRemove.Add(Index);
-			}
+			NewStatusEffectHandle = WeakThis->AddStatusEffect(StatusEffectTag);
 		}
 
-		for (int32 RemoveIndices : IndicesToRemove)
+		if (OnAdded)
 		{
-			ActiveStatusEffects.RemoveAt(RemoveIndices);
+			OnAdded(NewStatusEffectHandle);
 		}
-	}
-	
-	return NewStatusEffectHandle;
+	});
 }
 
 bool UAdaGameplayStateComponent::RemoveStatusEffect(FAdaStatusEffectHandle& StatusEffectHandle)
 {
+	WaitForPipelinedTick();
+
 	if (StatusEffectHandle.Identifier == INDEX_NONE || StatusEffectHandle.Index == INDEX_NONE)
 	{
 		return false;
 	}
 
+	if (!ActiveStatusEffects.IsValidIndex(StatusEffectHandle.Index))
+	{
+		return false;
+	}
+
+	// Slots are reused once their effect is removed, so make sure this is still the effect the handle was made for.
+	const UAdaStatusEffect* const StatusEffect = ActiveStatusEffects[StatusEffectHandle.Index].Get();
+	if (!IsValid(StatusEffect) || StatusEffect->EffectId != StatusEffectHandle.Identifier)
+	{
+		UE_LOG(LogAdaGameplayState, Error, TEXT("%hs: Got identifier mismatch at index %i."), __FUNCTION__, StatusEffectHandle.Index);
+		return false;
+	}
+
 	const bool bSuccess = RemoveStatusEffect_Internal(StatusEffectHandle.Index);
 	if (bSuccess)
 	{
@@ -543,11 +943,13 @@ bool UAdaGameplayStateComponent::RemoveStatusEffect(FAdaStatusEffectHandle& Stat
 
 bool UAdaGameplayStateComponent::ClearStatusEffect(const FGameplayTag StatusEffectTag)
 {
+	WaitForPipelinedTick();
+
 	TArray<int32> IndicesToRemove;
 	for (auto It = ActiveStatusEffects.CreateConstIterator(); It; ++It)
 	{
 		int32 Index = It.GetIndex();
-		const TStrongObjectPtr<UAdaStatusEffect> StatusEffectPtr = *It;
+		const TObjectPtr<UAdaStatusEffect> StatusEffectPtr = *It;
 		
 		const UAdaStatusEffect* const StatusEffect = StatusEffectPtr.Get();
 		if (!A_ENSURE(IsValid(StatusEffect)))
@@ -572,6 +974,8 @@ bool UAdaGameplayStateComponent::ClearStatusEffect(const FGameplayTag StatusEffe
 
 const UAdaStatusEffect* UAdaGameplayStateComponent::FindStatusEffect(const FAdaStatusEffectHandle& StatusEffectHandle) const
 {
+	WaitForPipelinedTick();
+
 	if (StatusEffectHandle.Identifier == INDEX_NONE || StatusEffectHandle.Index == INDEX_NONE)
 	{
 		return nullptr;
@@ -582,8 +986,9 @@ const UAdaStatusEffect* UAdaGameplayStateComponent::FindStatusEffect(const FAdaS
 		return nullptr;
 	}
 
+	// Slots are reused once their effect is removed, so make sure this is still the effect the handle was made for.
 	const UAdaStatusEffect* const StatusEffect = ActiveStatusEffects[StatusEffectHandle.Index].Get();
-	if (!IsValid(StatusEffect))
+	if (!IsValid(StatusEffect) || StatusEffect->EffectId != StatusEffectHandle.Identifier)
 	{
 		return nullptr;
 	}
@@ -593,24 +998,32 @@ const UAdaStatusEffect* UAdaGameplayStateComponent::FindStatusEffect(const FAdaS
 
 bool UAdaGameplayStateComponent::HasState(const FGameplayTag StateTag, bool bExactMatch) const
 {
+	WaitForPipelinedTick();
+
 	const FGameplayTagContainer& ExplicitStateTags = ActiveStates.GetTags();
 	return bExactMatch ? ExplicitStateTags.HasTagExact(StateTag) : ExplicitStateTags.HasTag(StateTag);
 }
 
 bool UAdaGameplayStateComponent::HasAnyState(const FGameplayTagContainer& StateTags, bool bExactMatch) const
 {
+	WaitForPipelinedTick();
+
 	const FGameplayTagContainer& ExplicitStateTags = ActiveStates.GetTags();
 	return bExactMatch ? ExplicitStateTags.HasAnyExact(StateTags) : ExplicitStateTags.HasAny(StateTags);
 }
 
 bool UAdaGameplayStateComponent::HasAllState(const FGameplayTagContainer& StateTags, bool bExactMatch) const
 {
+	WaitForPipelinedTick();
+
 	const FGameplayTagContainer& ExplicitStateTags = ActiveStates.GetTags();
 	return bExactMatch ? ExplicitStateTags.HasAllExact(StateTags) : ExplicitStateTags.HasAll(StateTags);
 }
 
 bool UAdaGameplayStateComponent::AddStateTag(const FGameplayTag StateTag)
 {
+	WaitForPipelinedTick();
+
 	A_ENSURE_MSG_RET(StateTag.IsValid(), false, TEXT("%hs: Attempted to add invalid state tag."), __FUNCTION__);
 	
 	ActiveStates.UpdateTagCount(StateTag, 1);
@@ -620,6 +1033,8 @@ bool UAdaGameplayStateComponent::AddStateTag(const FGameplayTag StateTag)
 
 bool UAdaGameplayStateComponent::RemoveStateTag(const FGameplayTag StateTag)
 {
+	WaitForPipelinedTick();
+
 	if (!ActiveStates.HasMatchingGameplayTag(StateTag))
 	{
 		return false;
@@ -630,49 +1045,56 @@ bool UAdaGameplayStateComponent::RemoveStateTag(const FGameplayTag StateTag)
 
 FAdaAttribute* UAdaGameplayStateComponent::FindAttribute_Internal(const FGameplayTag AttributeTag)
 {
-	for (auto It = Attributes.CreateIterator(); It; ++It)
-	{
-		FAdaAttribute& Attribute = *It;
-		if (Attribute.AttributeTag == AttributeTag)
-		{
-			return &Attribute;
-		}
-	}
+	WaitForPipelinedTick();
 
-	return nullptr;
+	const int32 Index = FindAttributeIndex(AttributeTag);
+	return Index != INDEX_NONE ? &Attributes[Index] : nullptr;
 }
 
 const FAdaAttribute* UAdaGameplayStateComponent::FindAttribute_Internal(const FGameplayTag AttributeTag) const
 {
-	for (auto It = Attributes.CreateConstIterator(); It; ++It)
-	{
-		const FAdaAttribute& Attribute = *It;
-		if (Attribute.AttributeTag == AttributeTag)
-		{
-			return &Attribute;
-		}
-	}
+	WaitForPipelinedTick();
 
-	return nullptr;
+	const int32 Index = FindAttributeIndex(AttributeTag);
+	return Index != INDEX_NONE ? &Attributes[Index] : nullptr;
 }
 
 FAdaAttribute* UAdaGameplayStateComponent::FindAttributeByIndex(int32 Index)
 {
+	WaitForPipelinedTick();
+
 	return Attributes.IsValidIndex(Index) ? &Attributes[Index] : nullptr;
 }
 
 const FAdaAttribute* UAdaGameplayStateComponent::FindAttributeByIndex(int32 Index) const
 {
+	WaitForPipelinedTick();
+
 	return Attributes.IsValidIndex(Index) ? &Attributes[Index] : nullptr;
 }
 
+FAdaAttribute* UAdaGameplayStateComponent::FindAttributeBySlot(const int32 Index, const FGameplayTag AttributeTag)
+{
+	FAdaAttribute* const Attribute = FindAttributeByIndex(Index);
+	if (Attribute && Attribute->AttributeTag == AttributeTag)
+	{
+		return Attribute;
+	}
+
+	return FindAttribute_Internal(AttributeTag);
+}
+
 FAdaAttributeModifier* UAdaGameplayStateComponent::FindModifierByIndex(int32 Index)
 {
+	WaitForPipelinedTick();
+
 	return ActiveModifiers.IsValidIndex(Index) ? &ActiveModifiers[Index] : nullptr;
 }
 
 const FAdaAttributeModifier* UAdaGameplayStateComponent::FindModifierByIndex(int32 Index) const
 {
+	WaitForPipelinedTick();
+
 	return ActiveModifiers.IsValidIndex(Index) ? &ActiveModifiers[Index] : nullptr;
 }
 
@@ -689,26 +1111,28 @@ bool UAdaGameplayStateComponent::RemoveModifierByIndex(int32 Index)
 
 bool UAdaGameplayStateComponent::RemoveModifier_Internal(FAdaAttributeModifier& Modifier, int32 Index)
 {
-	FAdaAttribute* Attribute = FindAttribute_Internal(Modifier.AffectedAttribute);
+	FAdaAttribute* Attribute = FindAttributeBySlot(Modifier.AffectedAttributeIndex, Modifier.AffectedAttribute);
 	A_ENSURE_RET(Attribute, false);
 
-	for (int32 i = Attribute->ActiveModifiers.Num() - 1; i >= 0; i--)
+	auto MatchesModifier = [&Modifier](const FAdaAttributeModifierHandle& ModifierHandle)
 	{
-		if (!ActiveModifiers.IsValidIndex(i))
-		{
-			break;
-		}
-		
-		FAdaAttributeModifierHandle& ModifierHandle = Attribute->ActiveModifiers[i];
-		if (!A_ENSURE(ModifierHandle.Identifier != INDEX_NONE))
-		{
-			continue;
-		}
+		A_ENSURE(ModifierHandle.Identifier != INDEX_NONE);
+		return ModifierHandle.Identifier == Modifier.Identifier;
+	};
 
-		if (ModifierHandle.Identifier == Modifier.Identifier)
-		{
-			Attribute->ActiveModifiers.RemoveAt(i);
-		}
+	Attribute->ActiveModifiers.RemoveAll(MatchesModifier);
+	if (Modifier.ApplicationType == EAdaAttributeModApplicationType::Duration)
+	{
+		Attribute->DurationModifierCount--;
+	}
+
+	if (Modifier.IsAggregated())
+	{
+		Attribute->CurrentAggregate.Remove(Modifier);
+	}
+	else if (Modifier.bAffectsBase)
+	{
+		Attribute->BaseModifiers.RemoveAll(MatchesModifier);
 	}
 
 	if (Attribute->bIsOverridden && Attribute->OverridingModifier.IsValid() && Attribute->OverridingModifier.Identifier == Modifier.GetIdentifier())
@@ -719,7 +1143,7 @@ bool UAdaGameplayStateComponent::RemoveModifier_Internal(FAdaAttributeModifier&
 
 	if (Modifier.CalculationType == EAdaAttributeModCalcType::SetByAttribute)
 	{
-		FAdaAttribute* ModifyingAttribute = FindAttribute_Internal(Modifier.ModifyingAttribute);
+		FAdaAttribute* ModifyingAttribute = FindAttributeBySlot(Modifier.ModifyingAttributeIndex, Modifier.ModifyingAttribute);
 		if (A_ENSURE(ModifyingAttribute))
 		{
 			ModifyingAttribute->AttributeDependencies.Remove(Modifier.AffectedAttribute);
@@ -750,12 +1174,125 @@ bool UAdaGameplayStateComponent::RemoveModifier_Internal(FAdaAttributeModifier&
 	}
 
 	Attribute->bIsDirty = true;
+	WakeUp();
 
+	RemoveFromTickList(Modifier);
 	ActiveModifiers.RemoveAt(Index);
 
 	return true;
 }
 
+void UAdaGameplayStateComponent::AddToTickList(const int32 Index)
+{
+	FAdaAttributeModifier& Modifier = ActiveModifiers[Index];
+	if (!Modifier.NeedsTicking())
+	{
+		return;
+	}
+
+	if (Modifier.IsScheduled())
+	{
+		ScheduleModifier(Index);
+		return;
+	}
+
+	TArray<int32>& TickList = Modifier.IsTimeDriven() ? TimedModifiers : DynamicModifiers;
+	Modifier.TickListIndex = TickList.Add(Index);
+
+	if (Modifier.RecalculatesOnGameThread())
+	{
+		GameThreadModifierCount++;
+	}
+}
+
+void UAdaGameplayStateComponent::RemoveFromTickList(FAdaAttributeModifier& Modifier)
+{
+	// Its event stays on the schedule, but won't match it once it comes due.
+	if (Modifier.bIsOnSchedule)
+	{
+		Modifier.bIsOnSchedule = false;
+		ScheduledModifierCount--;
+	}
+
+	if (Modifier.TickListIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	TArray<int32>& TickList = Modifier.IsTimeDriven() ? TimedModifiers : DynamicModifiers;
+	A_ENSURE_RET(TickList.IsValidIndex(Modifier.TickListIndex), void());
+
+	// Swap the last modifier in the list into this one's place, and let it know where it's moved to.
+	const int32 LastListIndex = TickList.Num() - 1;
+	if (Modifier.TickListIndex != LastListIndex)
+	{
+		ActiveModifiers[TickList[LastListIndex]].TickListIndex = Modifier.TickListIndex;
+	}
+
+	TickList.RemoveAtSwap(Modifier.TickListIndex, EAllowShrinking::No);
+	Modifier.TickListIndex = INDEX_NONE;
+
+	if (Modifier.RecalculatesOnGameThread())
+	{
+		GameThreadModifierCount--;
+	}
+}
+
+void UAdaGameplayStateComponent::ScheduleModifier(const int32 Index)
+{
+	if (!ActiveModifiers.IsValidIndex(Index))
+	{
+		return;
+	}
+
+	FAdaAttributeModifier& Modifier = ActiveModifiers[Index];
+	if (!Modifier.IsScheduled() || Modifier.bIsOnSchedule)
+	{
+		return;
+	}
+
+	// With nothing live on the schedule, anything left on it is for removed modifiers, so start afresh from the latest tick.
+	if (ScheduledModifierCount == 0)
+	{
+		ModifierSchedule.Reset(LatestTick);
+	}
+
+	// Events that should already have happened are picked up on the next tick.
+	ModifierSchedule.Schedule(FMath::Max(Modifier.GetNextScheduledTick(), LatestTick + 1), {Index, Modifier.Identifier});
+	Modifier.bIsOnSchedule = true;
+	ScheduledModifierCount++;
+}
+
+void UAdaGameplayStateComponent::CollectDueModifiers(const uint64 CurrentTick)
+{
+	DueModifiers.Reset();
+
+	// Anything left on the schedule with nothing live on it is for removed modifiers, so there's nothing to step through.
+	if (ScheduledModifierCount == 0)
+	{
+		ModifierSchedule.Reset(CurrentTick);
+		return;
+	}
+
+	ModifierSchedule.Advance(CurrentTick, [this](const uint64 DueTick, const FScheduledModifier& ScheduledModifier)
+	{
+		if (!ActiveModifiers.IsValidIndex(ScheduledModifier.Index))
+		{
+			return;
+		}
+
+		FAdaAttributeModifier& Modifier = ActiveModifiers[ScheduledModifier.Index];
+		if (Modifier.Identifier != ScheduledModifier.Identifier || !Modifier.bIsOnSchedule)
+		{
+			return;
+		}
+
+		Modifier.bIsOnSchedule = false;
+		ScheduledModifierCount--;
+		DueModifiers.Add(ScheduledModifier.Index);
+	});
+}
+
 void UAdaGameplayStateComponent::ApplyImmediateModifier(FAdaAttribute& Attribute, const FAdaAttributeModifierSpec& ModifierToApply)
 {
 	// Get base value.
@@ -821,8 +1358,10 @@ void UAdaGameplayStateComponent::ApplyOverridingModifier(FAdaAttribute& Attribut
 	}
 }
 
-void UAdaGameplayStateComponent::RecalculateAttribute(FAdaAttribute& Attribute, const uint64& CurrentTick)
+void UAdaGameplayStateComponent::RecalculateAttribute(FAdaAttribute& Attribute, const uint64& CurrentTick, const uint32 StepCount)
 {
+	const bool bMultiStep = StepCount > 1;
+
 	// Get base value.
 	float BaseValue = Attribute.BaseValue;
 	
@@ -840,8 +1379,15 @@ void UAdaGameplayStateComponent::RecalculateAttribute(FAdaAttribute& Attribute,
 
 	if (!bWasOverridden)
 	{
+		// Modifiers on the current value are kept aggregated as they change, so we only need to visit the modifiers on the base value,
+		// which apply on particular ticks.
+		if (Attribute.CurrentAggregate.NeedsRebuild())
+		{
+			RebuildAggregate(Attribute);
+		}
+
 		// Reset clamping values prior to potential recalculation.
-		Attribute.CurrentClampingValues = Attribute.BaseClampingValues;
+		Attribute.CurrentClampingValues = Attribute.BaseClampingValues + Attribute.CurrentAggregate.GetClampingDelta();
 		
 		// Calculation formula:
 		// ((BaseValue + Additive) * Multiply) + PostAdditive;
@@ -850,12 +1396,8 @@ void UAdaGameplayStateComponent::RecalculateAttribute(FAdaAttribute& Attribute,
 		float AggregatedBaseMultipliers = 1.0f;
 		float AggregatedBasePostAdditives = 0.0f;
 		
-		float AggregatedCurrentAdditives = 0.0f;
-		float AggregatedCurrentMultipliers = 1.0f;
-		float AggregatedCurrentPostAdditives = 0.0f;
-		
-		// Aggregate modifiers from the attribute's active modifier list.
-		for (FAdaAttributeModifierHandle& ModifierHandle : Attribute.ActiveModifiers)
+		// Aggregate modifiers from the attribute's base modifier list.
+		for (FAdaAttributeModifierHandle& ModifierHandle : Attribute.BaseModifiers)
 		{
 			FAdaAttributeModifier* Modifier = FindModifierByIndex(ModifierHandle.Index);
 			if (!Modifier)
@@ -864,7 +1406,8 @@ void UAdaGameplayStateComponent::RecalculateAttribute(FAdaAttribute& Attribute,
 				continue;
 			}
 
-			if (!Modifier->CanApply(CurrentTick))
+			// When catching up multiple ticks, base modifiers apply as many times as PrepareSteps counted.
+			if (bMultiStep ? Modifier->PendingApplicationCount == 0 : !Modifier->CanApply(CurrentTick))
 			{
 				continue;
 			}
@@ -877,57 +1420,45 @@ void UAdaGameplayStateComponent::RecalculateAttribute(FAdaAttribute& Attribute,
 				Attribute.CurrentClampingValues.Y += Modifier->ClampingParams.bHasMaxDelta ? Modifier->ClampingParams.MaxDelta : 0.0f;
 			}
 
-			float ModifierValue = Modifier->ModifierValue;
-			if (Modifier->bAffectsBase)
+			const float ModifierValue = bMultiStep ? Modifier->CalculateAggregateValue(Modifier->PendingApplicationCount) : Modifier->ModifierValue;
+			switch (Modifier->OperationType)
 			{
-				switch (Modifier->OperationType)
+				case EAdaAttributeModOpType::Additive:
 				{
-					case EAdaAttributeModOpType::Additive:
-					{
-						AggregatedBaseAdditives += ModifierValue;
-						break;
-					}
-					case EAdaAttributeModOpType::Multiply:
-					{
-						AggregatedBaseMultipliers *= ModifierValue;
-						break;
-					}
-					case EAdaAttributeModOpType::PostAdditive:
-					{
-						AggregatedBasePostAdditives += ModifierValue;
-						break;
-					}
-					default: break;
+					AggregatedBaseAdditives += ModifierValue;
+					break;
 				}
-			}
-			else
-			{
-				switch (Modifier->OperationType)
+				case EAdaAttributeModOpType::Multiply:
+				{
+					AggregatedBaseMultipliers *= ModifierValue;
+					break;
+				}
+				case EAdaAttributeModOpType::PostAdditive:
 				{
-					case EAdaAttributeModOpType::Additive:
-					{
-						AggregatedCurrentAdditives += ModifierValue;
-						break;
-					}
-					case EAdaAttributeModOpType::Multiply:
-					{
-						AggregatedCurrentMultipliers *= ModifierValue;
-						break;
-					}
-					case EAdaAttributeModOpType::PostAdditive:
-					{
-						AggregatedCurrentPostAdditives += ModifierValue;
-						break;
-					}
-					default: break;
+					AggregatedBasePostAdditives += ModifierValue;
+					break;
 				}
+				default: break;
 			}
 
-			Modifier->PostApply(CurrentTick);
+			if (bMultiStep)
+			{
+				Modifier->PostApplySteps();
+			}
+			else
+			{
+				Modifier->PostApply(CurrentTick);
+			}
 		}
 
 		// Decay towards target value slowly over time.
-		if (Attribute.bUsesTargetValue && !FMath::IsNearlyEqual(BaseValue, Attribute.TargetValue, 1E-03))
+		if (bMultiStep && Attribute.bUsesTargetValue)
+		{
+			// Decay for every tick we'd have recalculated on, without overshooting the target.
+			const float MaxDecay = Attribute.TargetDecayRate * FMath::Max<uint32>(Attribute.PendingStepCount, 1);
+			BaseValue += FMath::Clamp(Attribute.TargetValue - BaseValue, -MaxDecay, MaxDecay);
+		}
+		else if (Attribute.bUsesTargetValue && !FMath::IsNearlyEqual(BaseValue, Attribute.TargetValue, 1E-03))
 		{
 			if (BaseValue > Attribute.TargetValue)
 			{
@@ -940,7 +1471,7 @@ void UAdaGameplayStateComponent::RecalculateAttribute(FAdaAttribute& Attribute,
 		}
 
 		BaseValue = ((BaseValue + AggregatedBaseAdditives) * AggregatedBaseMultipliers) + AggregatedBasePostAdditives;
-		CurrentValue = ((BaseValue + AggregatedCurrentAdditives) * AggregatedCurrentMultipliers) + AggregatedCurrentPostAdditives;
+		CurrentValue = Attribute.CurrentAggregate.Apply(BaseValue);
 	}
 
 	// Clamp base and current if required.
@@ -971,6 +1502,22 @@ void UAdaGameplayStateComponent::RecalculateAttribute(FAdaAttribute& Attribute,
 
 	// We've finished recalculating, so this attribute is no longer dirty.
 	Attribute.bIsDirty = false;
+	Attribute.PendingStepCount = 0;
+}
+
+void UAdaGameplayStateComponent::RebuildAggregate(FAdaAttribute& Attribute)
+{
+	Attribute.CurrentAggregate.Reset();
+	for (const FAdaAttributeModifierHandle& ModifierHandle : Attribute.ActiveModifiers)
+	{
+		const FAdaAttributeModifier* const Modifier = FindModifierByIndex(ModifierHandle.Index);
+		if (Modifier && Modifier->IsAggregated())
+		{
+			Attribute.CurrentAggregate.Add(*Modifier);
+		}
+	}
+
+	Attribute.CurrentAggregate.MarkRebuilt();
 }
 
 bool UAdaGameplayStateComponent::DoesAttributeDependOnOther(const FGameplayTag AttributeTag, const FGameplayTag OtherAttributeTag) const
@@ -1003,17 +1550,17 @@ void UAdaGameplayStateComponent::NotifyAttributeChanged(FAdaAttribute& Attribute
 	// Update any modifiers that use this attribute and set those attributes as dirty for recalculation.
 	for (auto& [DependentAttributeTag, Index]: Attribute.AttributeDependencies)
 	{
-		FAdaAttribute* DependentAttribute = FindAttribute_Internal(DependentAttributeTag);
-		if (!DependentAttribute)
+		// Find the modifier that uses this attribute and update the value.
+		FAdaAttributeModifier* Modifier = FindModifierByIndex(Index);
+		if (!Modifier)
 		{
-			UE_LOG(LogAdaGameplayState, Warning, TEXT("%hs: Unable to find attribute %s on component %s"), __FUNCTION__, *DependentAttributeTag.ToString(), *GetNameSafe(this));
 			continue;
 		}
 
-		// Find the modifier that uses this attribute and update the value.
-		FAdaAttributeModifier* Modifier = FindModifierByIndex(Index);
-		if (!Modifier)
+		FAdaAttribute* DependentAttribute = FindAttributeBySlot(Modifier->AffectedAttributeIndex, DependentAttributeTag);
+		if (!DependentAttribute)
 		{
+			UE_LOG(LogAdaGameplayState, Warning, TEXT("%hs: Unable to find attribute %s on component %s"), __FUNCTION__, *DependentAttributeTag.ToString(), *GetNameSafe(this));
 			continue;
 		}
 
@@ -1022,48 +1569,124 @@ void UAdaGameplayStateComponent::NotifyAttributeChanged(FAdaAttribute& Attribute
 			continue;
 		}
 		
+		const float OldValue = Modifier->GetValue();
 		Modifier->SetValue(Attribute.CurrentValue);
+		if (Modifier->IsAggregated())
+		{
+			DependentAttribute->CurrentAggregate.ChangeValue(*Modifier, OldValue);
+		}
+
 		DependentAttribute->bIsDirty = true;
+		WakeUp();
+	}
+
+	const bool bHasSubscribers = Attribute.OnAttributeUpdated.IsBound()
+		|| (Attribute.bUsesClamping && Attribute.OnClampingValueHit.IsBound())
+		|| !Attribute.Thresholds.IsEmpty();
+
+	if (!bHasSubscribers)
+	{
+		return;
+	}
+
+	if (bDeferNotifications)
+	{
+		// Capture the values now, as the attribute may change again before the broadcast is replayed.
+		DeferredNotifications.Add([this, AttributeTag = Attribute.AttributeTag, NewBase = Attribute.BaseValue, NewCurrent = Attribute.CurrentValue, OldBase, OldCurrent]()
+		{
+			if (FAdaAttribute* const DeferredAttribute = FindAttribute_Internal(AttributeTag))
+			{
+				BroadcastAttributeChanged(*DeferredAttribute, NewBase, NewCurrent, OldBase, OldCurrent);
+			}
+		});
+
+		return;
 	}
 
+	BroadcastAttributeChanged(Attribute, Attribute.BaseValue, Attribute.CurrentValue, OldBase, OldCurrent);
+}
+
+void UAdaGameplayStateComponent::BroadcastAttributeChanged(FAdaAttribute& Attribute, const float NewBase, const float NewCurrent, const float OldBase, const float OldCurrent)
+{
 	if (Attribute.OnAttributeUpdated.IsBound())
 	{
-		Attribute.OnAttributeUpdated.Broadcast(Attribute.AttributeTag, Attribute.BaseValue, Attribute.CurrentValue, OldBase, OldCurrent);
+		Attribute.OnAttributeUpdated.Broadcast(Attribute.AttributeTag, NewBase, NewCurrent, OldBase, OldCurrent);
 	}
 
 	if (Attribute.bUsesClamping && Attribute.OnClampingValueHit.IsBound())
 	{
-		if (FMath::IsNearlyEqual(Attribute.BaseValue, Attribute.GetMaxValue(true)))
+		if (FMath::IsNearlyEqual(NewBase, Attribute.GetMaxValue(true)))
 		{
-			Attribute.OnClampingValueHit.Broadcast(Attribute.AttributeTag, Attribute.BaseValue, false, true);
+			Attribute.OnClampingValueHit.Broadcast(Attribute.AttributeTag, NewBase, false, true);
 		}
-		else if (FMath::IsNearlyEqual(Attribute.BaseValue, Attribute.GetMinValue(true)))
+		else if (FMath::IsNearlyEqual(NewBase, Attribute.GetMinValue(true)))
 		{
-			Attribute.OnClampingValueHit.Broadcast(Attribute.AttributeTag, Attribute.BaseValue, true, true);
+			Attribute.OnClampingValueHit.Broadcast(Attribute.AttributeTag, NewBase, true, true);
 		}
-		if (FMath::IsNearlyEqual(Attribute.CurrentValue, Attribute.GetMaxValue()))
+		if (FMath::IsNearlyEqual(NewCurrent, Attribute.GetMaxValue()))
 		{
-			Attribute.OnClampingValueHit.Broadcast(Attribute.AttributeTag, Attribute.BaseValue, false, false);
+			Attribute.OnClampingValueHit.Broadcast(Attribute.AttributeTag, NewBase, false, false);
 		}
-		else if (FMath::IsNearlyEqual(Attribute.CurrentValue, Attribute.GetMinValue()))
+		else if (FMath::IsNearlyEqual(NewCurrent, Attribute.GetMinValue()))
 		{
-			Attribute.OnClampingValueHit.Broadcast(Attribute.AttributeTag, Attribute.BaseValue, false, false);
+			Attribute.OnClampingValueHit.Broadcast(Attribute.AttributeTag, NewBase, false, false);
 		}
 	}
 	
 	for (FAdaAttributeThresholdDelegate& Threshold : Attribute.Thresholds)
 	{
-		if (OldCurrent < Threshold.ThresholdValue && Attribute.CurrentValue >= Threshold.ThresholdValue)
+		if (OldCurrent < Threshold.ThresholdValue && NewCurrent >= Threshold.ThresholdValue)
 		{
-			Threshold.Delegate.Broadcast(Attribute.AttributeTag, Threshold.ThresholdValue, Attribute.CurrentValue, EAdaAttributeDelta::Ascending);
+			Threshold.Delegate.Broadcast(Attribute.AttributeTag, Threshold.ThresholdValue, NewCurrent, EAdaAttributeDelta::Ascending);
 		}
-		else if (OldCurrent > Threshold.ThresholdValue && Attribute.CurrentValue <= Threshold.ThresholdValue)
+		else if (OldCurrent > Threshold.ThresholdValue && NewCurrent <= Threshold.ThresholdValue)
 		{
-			Threshold.Delegate.Broadcast(Attribute.AttributeTag, Threshold.ThresholdValue, Attribute.CurrentValue, EAdaAttributeDelta::Descending);
+			Threshold.Delegate.Broadcast(Attribute.AttributeTag, Threshold.ThresholdValue, NewCurrent, EAdaAttributeDelta::Descending);
 		}
 	}
 }
 
+void UAdaGameplayStateComponent::BroadcastPostFixedTick()
+{
+	if (!OnPostFixedTick.IsBound())
+	{
+		return;
+	}
+
+	if (bDeferNotifications)
+	{
+		DeferredNotifications.Add([this]()
+		{
+			OnPostFixedTick.Broadcast();
+		});
+
+		return;
+	}
+
+	OnPostFixedTick.Broadcast();
+}
+
+void UAdaGameplayStateComponent::FlushDeferredNotifications()
+{
+	A_ENSURE_RET(!bDeferNotifications, void());
+
+	// Broadcasts may queue further changes, so take the queue before replaying it.
+	TArray<TUniqueFunction<void()>> Notifications = MoveTemp(DeferredNotifications);
+	for (TUniqueFunction<void()>& Notification : Notifications)
+	{
+		Notification();
+	}
+}
+
+void UAdaGameplayStateComponent::WaitForPipelinedTick() const
+{
+	// The thread running the pipelined tick goes through the same lookups, and mustn't wait on itself.
+	if (PipelinedTickOwner != nullptr && IsInGameThread() && !UAdaGameplayStateManager::IsRunningPipelinedTick())
+	{
+		PipelinedTickOwner->CompletePipelinedTicks();
+	}
+}
+
 int32 UAdaGameplayStateComponent::GetNextAttributeId()
 {
 	LatestModifierId++;
@@ -1109,19 +1732,10 @@ bool UAdaGameplayStateComponent::RemoveStatusEffect_Internal(const int32 Index)
 
 	const FGameplayTag StatusEffectTag = StatusEffect->GetEffectTag();
 
-	const UWorld* const World = GetWorld();
-	A_ENSURE_RET(IsValid(World), false);
-
-	const AAdaGameState* const GameState = World->GetGameState<AAdaGameState>();
-	A_ENSURE_RET(IsValid(GameState), false);
-
-	const UAdaGameplayStateManager* const StateManager = GameState->GetGameplayStateManager();
-	A_ENSURE_RET(IsValid(StateManager), false);
-
-	const UAdaStatusEffectDefinition* const StatusEffectDef = StateManager->GetStatusEffectDefinition(StatusEffectTag);
-	A_ENSURE_RET(IsValid(StatusEffectDef), false);
+	const FAdaCompiledStatusEffect* const CompiledEffect = StatusEffect->CompiledDefinition.Get();
+	A_ENSURE_RET(CompiledEffect, false);
 	
-	ActiveStates.UpdateTagCount(StatusEffectDef->StateTagsToAdd, -1);
+	ActiveStates.UpdateTagCount(CompiledEffect->StateTagsToAdd, -1);
 	ActiveStatusEffectTags.UpdateTagCount(StatusEffectTag, -1);
 
 	// Reverse iteration as we'll be modifying the active modifier handles array as we remove modifiers.
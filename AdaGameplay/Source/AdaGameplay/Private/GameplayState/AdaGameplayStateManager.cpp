@@ -3,23 +3,94 @@
 #include "GameplayState/AdaGameplayStateManager.h"
 
 #include "Engine/World.h"
+#include "Async/ParallelFor.h"
+#include "DataRegistry.h"
 #include "DataRegistrySubsystem.h"
 #include "Engine/AssetManager.h"
 #include "Curves/CurveFloat.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Tasks/Task.h"
+#include "UObject/UObjectGlobals.h"
 
+#include "GameFramework/AdaGameState.h"
 #include "Simulation/AdaTickManager.h"
 #include "GameplayState/AdaGameplayStateComponent.h"
+#include "GameplayState/AdaGameplayStateSettings.h"
 #include "Debug/AdaAssertionMacros.h"
 #include "GameplayState/AdaAttributeSet.h"
+#include "GameplayState/AdaStatusEffect.h"
 #include "GameplayState/AdaStatusEffectDefinition.h"
+#include "GameplayState/AdaAttributeFunctionLibrary.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AdaGameplayStateManager)
 
 DEFINE_LOG_CATEGORY(LogAdaGameplayStateManager);
 
+// How much weight each new cost measurement has when smoothing component costs.
+static constexpr float ComponentCostSmoothing = 0.25f;
+
+// Set on whichever thread is running a pipelined bucket tick, so that components don't wait on the tick that's running them.
+static thread_local bool bIsRunningPipelinedTickOnThisThread = false;
+
+// How many bucket frames must build up before a component in the given tier is ticked.
+static uint32 GetTickTierRateDivisor(const EAdaGameplayStateTickTier Tier)
+{
+	switch (Tier)
+	{
+		case EAdaGameplayStateTickTier::Full: return 1;
+		case EAdaGameplayStateTickTier::Half: return 2;
+		case EAdaGameplayStateTickTier::Quarter: return 4;
+		case EAdaGameplayStateTickTier::Dormant: return MAX_uint32;
+		default: break;
+	}
+
+	return 1;
+}
+
+static TAutoConsoleVariable<int32> CVarTickBucketCount(
+	TEXT("Ada.GameplayState.TickBucketCount"),
+	0,
+	TEXT("Override the number of gameplay state tick buckets, between 1 and 255. Applied at the end of the current round of buckets. 0 uses the developer setting."),
+	ECVF_Default);
+
+static FAutoConsoleCommandWithWorld CVarDumpStatusEffectLoads(
+	TEXT("Ada.GameplayState.DumpStatusEffectLoads"),
+	TEXT("Log how long loading status effect definitions has taken, and how much memory they're using."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		const AAdaGameState* const GameState = IsValid(World) ? World->GetGameState<AAdaGameState>() : nullptr;
+		const UAdaGameplayStateManager* const StateManager = IsValid(GameState) ? GameState->GetGameplayStateManager() : nullptr;
+		if (!IsValid(StateManager))
+		{
+			UE_LOG(LogAdaGameplayStateManager, Warning, TEXT("Ada.GameplayState.DumpStatusEffectLoads: No gameplay state manager for the current world."));
+			return;
+		}
+
+		StateManager->DumpStatusEffectLoads();
+	}));
+
+static FAutoConsoleCommandWithWorld CVarDumpBucketLoads(
+	TEXT("Ada.GameplayState.DumpBucketLoads"),
+	TEXT("Log the load of each gameplay state tick bucket."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		const AAdaGameState* const GameState = IsValid(World) ? World->GetGameState<AAdaGameState>() : nullptr;
+		const UAdaGameplayStateManager* const StateManager = IsValid(GameState) ? GameState->GetGameplayStateManager() : nullptr;
+		if (!IsValid(StateManager))
+		{
+			UE_LOG(LogAdaGameplayStateManager, Warning, TEXT("Ada.GameplayState.DumpBucketLoads: No gameplay state manager for the current world."));
+			return;
+		}
+
+		StateManager->DumpBucketLoads();
+	}));
+
 UAdaGameplayStateManager::UAdaGameplayStateManager()
 {
-	PrimaryComponentTick.bCanEverTick = false;
+	// We only tick when spreading bucket ticks across engine frames. Everything else happens on fixed steps.
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
 	bWantsInitializeComponent = true;
 }
 
@@ -27,11 +98,25 @@ void UAdaGameplayStateManager::InitializeComponent()
 {
 	Super::InitializeComponent();
 
+	TickBuckets.SetNum(GetDesiredTickBucketCount());
+
 	// Ideally, this should probably go into a world subsystem, but I'd prefer to encapsulate all global gameplay state
 	// functionality on this component. If this proves to be a problem, it can be moved later.
 	UAssetManager& AssetManager = UAssetManager::Get();
 	FStreamableDelegate StreamableDelegate = FStreamableDelegate::CreateUObject(this, &UAdaGameplayStateManager::OnStatusEffectDefsLoaded);
-	AssetManager.LoadPrimaryAssetsWithType(UAdaStatusEffectDefinition::PrimaryAssetType, TArray<FName>(), StreamableDelegate, FStreamableManager::AsyncLoadHighPriority);
+	PreloadStartTime = FPlatformTime::Seconds();
+
+	const UAdaGameplayStateSettings* const Settings = GetDefault<UAdaGameplayStateSettings>();
+	if (!IsValid(Settings) || Settings->bPreloadAllStatusEffects)
+	{
+		AssetManager.LoadPrimaryAssetsWithType(UAdaStatusEffectDefinition::PrimaryAssetType, TArray<FName>(), StreamableDelegate, FStreamableManager::AsyncLoadHighPriority);
+		return;
+	}
+
+	// Anything not preloaded is streamed in when it's first applied.
+	TArray<FPrimaryAssetId> PreloadAssetIds;
+	GatherPreloadedStatusEffects(PreloadAssetIds);
+	AssetManager.LoadPrimaryAssets(PreloadAssetIds, TArray<FName>(), StreamableDelegate, FStreamableManager::AsyncLoadHighPriority);
 }
 
 void UAdaGameplayStateManager::BeginPlay()
@@ -45,6 +130,13 @@ void UAdaGameplayStateManager::BeginPlay()
 	A_ENSURE_RET(IsValid(TickManager), void());
 
 	TickManager->RegisterTickFunction(this, &UAdaGameplayStateManager::FixedTick);
+
+	SetComponentTickEnabled(bSpreadBucketsAcrossFrames);
+
+	BakeCurveModifiers();
+
+	// Components being ticked in the background must stay alive until they've been joined.
+	PreGarbageCollectHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddUObject(this, &UAdaGameplayStateManager::CompletePipelinedTicks);
 }
 
 void UAdaGameplayStateManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -53,6 +145,10 @@ void UAdaGameplayStateManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
 	{
 		Super::EndPlay(EndPlayReason);
 	};
+
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGarbageCollectHandle);
+	CompletePipelinedTicks();
+	SpreadBucketTicks.Empty();
 	
 	const UWorld* const World = GetWorld();
 	A_VALIDATE_OBJ(World, void());
@@ -62,30 +158,149 @@ void UAdaGameplayStateManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
 
 	TickManager->UnregisterTickFunction(this);
 
+	for (FTickBucket& Bucket : TickBuckets)
+	{
+		Bucket.Components.Empty();
+		Bucket.LoadMS = 0.0f;
+	}
+
+	ComponentToBucketMap.Empty();
+	SleepingEntries.Empty();
 	LoadedStatusEffectDefinitions.Empty();
+	CompiledStatusEffects.Empty();
+	PendingStatusEffectLoads.Empty();
+	StreamedStatusEffects.Empty();
+	BakedModifierCurves.Empty();
+}
+
+void UAdaGameplayStateManager::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	TickSpreadBuckets(DeltaTime);
 }
 
 void UAdaGameplayStateManager::RegisterStateComponent(UAdaGameplayStateComponent* StateComponent)
 {
 	A_VALIDATE_OBJ(StateComponent, void());
 
-	TickBuckets[NextBucketToAssign].Components.Add(StateComponent);
-	ComponentToBucketMap.Add({StateComponent, NextBucketToAssign});
+	if (ComponentToBucketMap.Contains(StateComponent))
+	{
+		return;
+	}
+
+	if (TickBuckets.IsEmpty())
+	{
+		TickBuckets.SetNum(GetDesiredTickBucketCount());
+	}
+
+	const uint8 BucketIndex = FindLeastLoadedBucket();
+
+	FTickBucketEntry& Entry = TickBuckets[BucketIndex].Components.AddDefaulted_GetRef();
+	Entry.Component = StateComponent;
+	Entry.ComponentKey = FObjectKey(StateComponent);
+	Entry.CostMS = EstimateComponentCost(StateComponent);
+	Entry.NextFrame = TickBuckets[BucketIndex].CurrentFrame;
+	Entry.Tier = TickTierScorer.IsBound() ? TickTierScorer.Execute(StateComponent) : EAdaGameplayStateTickTier::Full;
 
-	IncrementAssignmentCounter();
+	TickBuckets[BucketIndex].LoadMS += Entry.GetEffectiveCostMS();
+	ComponentToBucketMap.Add(Entry.ComponentKey, BucketIndex);
 }
 
 void UAdaGameplayStateManager::UnregisterStateComponent(UAdaGameplayStateComponent* StateComponent)
 {
 	A_VALIDATE_OBJ(StateComponent, void());
 
-	uint8* FoundBucket = ComponentToBucketMap.Find(StateComponent);
-	if (!FoundBucket)
+	if (StateComponent->PipelinedTickOwner == this)
+	{
+		CompletePipelinedTicks();
+	}
+
+	uint8 BucketIndex = 0;
+	if (!ComponentToBucketMap.RemoveAndCopyValue(StateComponent, BucketIndex))
+	{
+		return;
+	}
+
+	if (SleepingEntries.Remove(StateComponent) > 0)
+	{
+		StateComponent->bIsAsleep = false;
+		return;
+	}
+
+	FTickBucket& Bucket = TickBuckets[BucketIndex];
+	const int32 EntryIndex = Bucket.Components.IndexOfByPredicate([StateComponent](const FTickBucketEntry& Entry) { return Entry.Component == StateComponent; });
+	if (EntryIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	Bucket.LoadMS = FMath::Max(Bucket.LoadMS - Bucket.Components[EntryIndex].GetEffectiveCostMS(), 0.0f);
+
+	// We may be partway through iterating a bucket, or have ticks in the background that refer to entries by index,
+	// so leave a hole to be cleaned up once the bucket is next finished.
+	if (bIsTickingBucket || HasBucketTicksInFlight())
+	{
+		Bucket.Components[EntryIndex] = FTickBucketEntry();
+	}
+	else
+	{
+		Bucket.Components.RemoveAtSwap(EntryIndex, EAllowShrinking::No);
+	}
+}
+
+void UAdaGameplayStateManager::WakeStateComponent(UAdaGameplayStateComponent* StateComponent)
+{
+	A_VALIDATE_OBJ(StateComponent, void());
+
+	FTickBucketEntry Entry;
+	if (!SleepingEntries.RemoveAndCopyValue(StateComponent, Entry))
+	{
+		return;
+	}
+
+	const uint8 BucketIndex = ComponentToBucketMap.FindChecked(Entry.ComponentKey);
+	FTickBucket& Bucket = TickBuckets[BucketIndex];
+
+	// Nothing happened to the component while it was asleep, so rather than catching up, it picks up from its bucket's next frame.
+	Entry.NextFrame = Bucket.CurrentFrame;
+	StateComponent->LatestTick = FMath::Max(StateComponent->LatestTick, Bucket.CurrentFrame > 0 ? Bucket.CurrentFrame - 1 : 0);
+	StateComponent->bIsAsleep = false;
+
+	// Appending keeps the indices of any entries that are being ticked right now stable.
+	Bucket.LoadMS += Entry.GetEffectiveCostMS();
+	Bucket.Components.Add(MoveTemp(Entry));
+}
+
+void UAdaGameplayStateManager::CatchUpStateComponent(UAdaGameplayStateComponent* StateComponent)
+{
+	A_VALIDATE_OBJ(StateComponent, void());
+
+	// Components can only be ticked out of turn from the game thread. Anything being ticked elsewhere is already on its way to its bucket's frame.
+	if (!IsInGameThread() || IsRunningPipelinedTick())
+	{
+		return;
+	}
+
+	// Sleeping components pick up from their bucket's frame when they're woken, and there's nothing to do for unregistered ones.
+	FTickBucketEntry* const Entry = FindEntry(StateComponent);
+	if (!Entry)
+	{
+		return;
+	}
+
+	const FTickBucket& Bucket = TickBuckets[ComponentToBucketMap.FindChecked(StateComponent)];
+	if (Bucket.CurrentFrame == 0 || Entry->NextFrame >= Bucket.CurrentFrame)
 	{
 		return;
 	}
 
-	TickBuckets[*FoundBucket].Components.Remove(StateComponent);
+	// Catch up on everything the component has missed, regardless of its tier, exactly as if its turn had come up.
+	const uint64 LastFrame = Bucket.CurrentFrame - 1;
+	const uint32 PendingSteps = static_cast<uint32>(FMath::Min<uint64>(LastFrame + 1 - Entry->NextFrame, MAX_uint32));
+	Entry->NextFrame = LastFrame + 1;
+
+	TickStateComponent(StateComponent, LastFrame, PendingSteps);
 }
 
 const UAdaStatusEffectDefinition* UAdaGameplayStateManager::GetStatusEffectDefinition(const FGameplayTag EffectTag) const
@@ -101,6 +316,99 @@ void UAdaGameplayStateManager::GetAllStatusEffectTags(TArray<FGameplayTag>& OutT
 	return LoadedStatusEffectDefinitions.GenerateKeyArray(OutTags);
 }
 
+TSharedPtr<const FAdaCompiledStatusEffect> UAdaGameplayStateManager::GetCompiledStatusEffect(const FGameplayTag EffectTag) const
+{
+	const TSharedRef<const FAdaCompiledStatusEffect>* const FoundCompiledEffect = CompiledStatusEffects.Find(EffectTag);
+	A_ENSURE_MSG_RET(FoundCompiledEffect, nullptr, TEXT("%hs: Could not find compiled status effect for tag %s."), __FUNCTION__, *EffectTag.ToString());
+
+	return *FoundCompiledEffect;
+}
+
+void UAdaGameplayStateManager::RequestStatusEffectLoad(const FGameplayTag EffectTag, TUniqueFunction<void(const bool)>&& OnLoaded)
+{
+	if (IsStatusEffectLoaded(EffectTag))
+	{
+		if (OnLoaded)
+		{
+			OnLoaded(true);
+		}
+
+		return;
+	}
+
+	if (FPendingStatusEffectLoad* const PendingLoad = PendingStatusEffectLoads.Find(EffectTag))
+	{
+		if (OnLoaded)
+		{
+			PendingLoad->Callbacks.Add(MoveTemp(OnLoaded));
+		}
+
+		return;
+	}
+
+	FPendingStatusEffectLoad& PendingLoad = PendingStatusEffectLoads.Add(EffectTag);
+	PendingLoad.StartTime = FPlatformTime::Seconds();
+	if (OnLoaded)
+	{
+		PendingLoad.Callbacks.Add(MoveTemp(OnLoaded));
+	}
+
+	UAssetManager& AssetManager = UAssetManager::Get();
+	const FPrimaryAssetId AssetId(UAdaStatusEffectDefinition::PrimaryAssetType, EffectTag.GetTagName());
+	FStreamableDelegate StreamableDelegate = FStreamableDelegate::CreateUObject(this, &UAdaGameplayStateManager::OnStatusEffectDefStreamed, EffectTag);
+	if (!AssetManager.LoadPrimaryAsset(AssetId, TArray<FName>(), StreamableDelegate, FStreamableManager::AsyncLoadHighPriority).IsValid())
+	{
+		// Nothing to wait on: either it doesn't exist, or it was loaded by someone else, and the delegate has already been called.
+		if (PendingStatusEffectLoads.Contains(EffectTag))
+		{
+			OnStatusEffectDefStreamed(EffectTag);
+		}
+	}
+}
+
+void UAdaGameplayStateManager::ReleaseUnusedStatusEffects()
+{
+	const UAdaGameplayStateSettings* const Settings = GetDefault<UAdaGameplayStateSettings>();
+	A_ENSURE_RET(IsValid(Settings), void());
+
+	UAssetManager& AssetManager = UAssetManager::Get();
+	const double CurrentTime = FPlatformTime::Seconds();
+	for (auto It = StreamedStatusEffects.CreateIterator(); It; ++It)
+	{
+		const FGameplayTag EffectTag = It.Key();
+		const TSharedRef<const FAdaCompiledStatusEffect>* const CompiledEffect = CompiledStatusEffects.Find(EffectTag);
+
+		// Live status effects hold on to their compiled definition, so it's in use for as long as anyone else is holding it.
+		if (CompiledEffect && !CompiledEffect->IsUnique())
+		{
+			It.Value().LastUsedTime = CurrentTime;
+			continue;
+		}
+
+		if (CurrentTime - It.Value().LastUsedTime < Settings->StatusEffectReleaseDelaySeconds)
+		{
+			continue;
+		}
+
+		LoadedStatusEffectBytes -= It.Value().SizeBytes;
+		LoadedStatusEffectDefinitions.Remove(EffectTag);
+		CompiledStatusEffects.Remove(EffectTag);
+		AssetManager.UnloadPrimaryAsset(FPrimaryAssetId(UAdaStatusEffectDefinition::PrimaryAssetType, EffectTag.GetTagName()));
+		StatusEffectReleaseCount++;
+		It.RemoveCurrent();
+
+		UE_LOG(LogAdaGameplayStateManager, Verbose, TEXT("%hs: Released unused status effect definition %s."), __FUNCTION__, *EffectTag.ToString());
+	}
+}
+
+void UAdaGameplayStateManager::DumpStatusEffectLoads() const
+{
+	UE_LOG(LogAdaGameplayStateManager, Display, TEXT("Status effect definitions: %i loaded (%i streamed, %i pending), using %.1fKB."),
+		LoadedStatusEffectDefinitions.Num(), StreamedStatusEffects.Num(), PendingStatusEffectLoads.Num(), LoadedStatusEffectBytes / 1024.0);
+	UE_LOG(LogAdaGameplayStateManager, Display, TEXT("%i loads taking %.2fms in total, %i releases."),
+		StatusEffectLoadCount, StatusEffectLoadSeconds * 1000.0, StatusEffectReleaseCount);
+}
+
 const UCurveFloat* UAdaGameplayStateManager::GetCurveForModifier(const FGameplayTag CurveTag) const
 {
 	const UDataRegistrySubsystem* const DataRegistrySubsystem = UDataRegistrySubsystem::Get();
@@ -112,6 +420,19 @@ const UCurveFloat* UAdaGameplayStateManager::GetCurveForModifier(const FGameplay
 	return CurveModifierRow->Curve;
 }
 
+TSharedPtr<const FAdaBakedCurve> UAdaGameplayStateManager::GetBakedCurveForModifier(const FGameplayTag CurveTag)
+{
+	if (const TSharedRef<const FAdaBakedCurve>* const FoundCurve = BakedModifierCurves.Find(CurveTag))
+	{
+		return *FoundCurve;
+	}
+
+	// The cache is only written from the game thread; ticks running elsewhere can only use curves that were baked up front.
+	A_ENSURE_MSG_RET(IsInGameThread(), nullptr, TEXT("%hs: Curve %s hasn't been baked, and can't be baked off the game thread."), __FUNCTION__, *CurveTag.ToString());
+
+	return BakeModifierCurve(CurveTag, GetCurveForModifier(CurveTag));
+}
+
 const FAdaAttributeSet* UAdaGameplayStateManager::GetAttributeSet(const FGameplayTag SetTag) const
 {
 	const UDataRegistrySubsystem* const DataRegistrySubsystem = UDataRegistrySubsystem::Get();
@@ -123,47 +444,976 @@ const FAdaAttributeSet* UAdaGameplayStateManager::GetAttributeSet(const FGamepla
 	return AttributeSetRow;
 }
 
-void UAdaGameplayStateManager::FixedTick(const uint64& CurrentFrame)
+void UAdaGameplayStateManager::BakeCurveModifiers()
 {
-	FTickBucket& BucketToTick = TickBuckets[NextBucketToTick];
-	for (TWeakObjectPtr<UAdaGameplayStateComponent> ComponentWeak : BucketToTick.Components)
+	const UDataRegistrySubsystem* const DataRegistrySubsystem = UDataRegistrySubsystem::Get();
+	A_ENSURE_RET(IsValid(DataRegistrySubsystem), void());
+
+	const UDataRegistry* const Registry = DataRegistrySubsystem->GetRegistryForType(CurveModifierRegistry.GetName());
+	A_ENSURE_MSG_RET(IsValid(Registry), void(), TEXT("%hs: Could not find curve modifier registry %s."), __FUNCTION__, *CurveModifierRegistry.ToString());
+
+	TMap<FDataRegistryId, const uint8*> CachedItems;
+	const UScriptStruct* ItemStruct = nullptr;
+	Registry->GetAllCachedItems(CachedItems, ItemStruct);
+	A_ENSURE_RET(ItemStruct && ItemStruct->IsChildOf(FAdaAttributeCurveModifierRow::StaticStruct()), void());
+
+	for (const TPair<FDataRegistryId, const uint8*>& CachedItem : CachedItems)
 	{
-		UAdaGameplayStateComponent* ComponentToTick = ComponentWeak.Get();
-		if (!IsValid(ComponentToTick))
+		const FAdaAttributeCurveModifierRow* const CurveModifierRow = reinterpret_cast<const FAdaAttributeCurveModifierRow*>(CachedItem.Value);
+		BakeModifierCurve(CurveModifierRow->GetRowTag(), CurveModifierRow->Curve);
+	}
+
+	UE_LOG(LogAdaGameplayStateManager, Log, TEXT("%hs: Baked %d curve modifier curves."), __FUNCTION__, BakedModifierCurves.Num());
+}
+
+TSharedPtr<const FAdaBakedCurve> UAdaGameplayStateManager::BakeModifierCurve(const FGameplayTag CurveTag, const UCurveFloat* const Curve)
+{
+	A_ENSURE_MSG_RET(IsValid(Curve), nullptr, TEXT("%hs: Invalid Curve Float asset for modifier %s."), __FUNCTION__, *CurveTag.ToString());
+
+	const UAdaGameplayStateSettings* const Settings = GetDefault<UAdaGameplayStateSettings>();
+	A_ENSURE_RET(IsValid(Settings), nullptr);
+
+	const FRichCurve& SourceCurve = Curve->FloatCurve;
+	if (SourceCurve.PreInfinityExtrap != RCCE_Constant || SourceCurve.PostInfinityExtrap != RCCE_Constant)
+	{
+		UE_LOG(LogAdaGameplayStateManager, Warning, TEXT("%hs: Curve %s for modifier %s extrapolates past its keys, but will be clamped to them once baked."),
+			__FUNCTION__, *Curve->GetName(), *CurveTag.ToString());
+	}
+
+	TSharedRef<FAdaBakedCurve> BakedCurve = MakeShared<FAdaBakedCurve>();
+	const float MaxError = BakedCurve->Bake(SourceCurve, Settings->MinCurveBakeResolution, Settings->MaxCurveBakeResolution, Settings->CurveBakeTolerance);
+	if (MaxError > Settings->CurveBakeTolerance)
+	{
+		UE_LOG(LogAdaGameplayStateManager, Warning, TEXT("%hs: Curve %s for modifier %s is off by up to %f at %d samples, which is outside of the tolerance of %f."),
+			__FUNCTION__, *Curve->GetName(), *CurveTag.ToString(), MaxError, BakedCurve->GetResolution(), Settings->CurveBakeTolerance);
+	}
+
+	BakedModifierCurves.Add(CurveTag, BakedCurve);
+
+	return BakedCurve;
+}
+
+void UAdaGameplayStateManager::OnRoundFinished()
+{
+	// Resize, rescore and rebalance once every bucket has had its turn, at which point they're all on the same frame.
+	const int32 DesiredBucketCount = GetDesiredTickBucketCount();
+	if (DesiredBucketCount != TickBuckets.Num())
+	{
+		ResizeTickBuckets(DesiredBucketCount);
+	}
+
+	if (++RoundsSinceTickTierUpdate >= TickTierUpdateRounds)
+	{
+		RoundsSinceTickTierUpdate = 0;
+		UpdateTickTiers();
+	}
+
+	RebalanceBuckets();
+
+	ReleaseUnusedStatusEffects();
+}
+
+void UAdaGameplayStateManager::FixedTick(const uint64& CurrentFrame, const uint32 StepCount)
+{
+	A_ENSURE_RET(!TickBuckets.IsEmpty(), void());
+
+	// Land the results of the bucket ticks we started last step before starting this step's.
+	CompletePipelinedTicks();
+	CompleteSpreadBucketTicks();
+
+	if (StepCount <= 1)
+	{
+		TickBucket(NextBucketToTick, 1);
+		IncrementTickCounter();
+
+		if (NextBucketToTick == 0)
 		{
-			continue;
+			FinishRound();
+		}
+
+		return;
+	}
+
+	// Several steps at once can take us across the end of a round without landing on it, so split them up at each round boundary.
+	// Each pass either finishes off the current round, or runs as many whole rounds as we can, with every bucket taking all of its turns at once.
+	uint32 RemainingSteps = StepCount;
+	while (RemainingSteps > 0)
+	{
+		// Finishing a round can resize the buckets, so look the count up again each pass.
+		const uint32 BucketCount = TickBuckets.Num();
+
+		uint32 PassSteps = 0;
+		if (NextBucketToTick == 0 && RemainingSteps >= BucketCount)
+		{
+			const uint32 FullRounds = RemainingSteps / BucketCount;
+			for (uint32 BucketIndex = 0; BucketIndex < BucketCount; BucketIndex++)
+			{
+				TickBucket(static_cast<uint8>(BucketIndex), FullRounds);
+			}
+
+			PassSteps = FullRounds * BucketCount;
 		}
-		
-		ComponentToTick->FixedTick(BucketToTick.CurrentFrame);
+		else
+		{
+			PassSteps = FMath::Min(RemainingSteps, BucketCount - NextBucketToTick);
+			for (uint32 Offset = 0; Offset < PassSteps; Offset++)
+			{
+				TickBucket(static_cast<uint8>(NextBucketToTick + Offset), 1);
+			}
+
+			NextBucketToTick = (NextBucketToTick + PassSteps) % BucketCount;
+		}
+
+		RemainingSteps -= PassSteps;
+
+		if (NextBucketToTick == 0)
+		{
+			// Buckets in flight have to land before the round can finish, and before the next round can start on top of them.
+			if (RemainingSteps > 0)
+			{
+				CompletePipelinedTicks();
+				CompleteSpreadBucketTicks();
+			}
+
+			FinishRound();
+		}
+	}
+}
+
+void UAdaGameplayStateManager::FinishRound()
+{
+	// Every bucket has had its turn, but if any are still ticking in the background or across engine frames,
+	// they won't all be on the same frame until they've finished.
+	if (!HasBucketTicksInFlight())
+	{
+		OnRoundFinished();
+	}
+	else
+	{
+		bRoundFinishPending = true;
+	}
+}
+
+void UAdaGameplayStateManager::TickBucket(const uint8 BucketIndex, const uint32 StepCount)
+{
+	if (bPipelineBucketTicks && FApp::ShouldUseThreadingForPerformance())
+	{
+		LaunchPipelinedBucketTick(BucketIndex, StepCount);
+		return;
+	}
+
+	FTickBucket& BucketToTick = TickBuckets[BucketIndex];
+
+	// Components registered while we're ticking will get their first tick next round.
+	const int32 ComponentCount = BucketToTick.Components.Num();
+
+	if (bSpreadBucketsAcrossFrames)
+	{
+		// The bucket stays on its current frame until every component has been ticked, which happens over the engine frames before the next step.
+		FSpreadBucketTick& SpreadTick = SpreadBucketTicks.AddDefaulted_GetRef();
+		SpreadTick.BucketIndex = BucketIndex;
+		SpreadTick.StepCount = StepCount;
+		SpreadTick.EndIndex = ComponentCount;
+		return;
 	}
 
-	BucketToTick.CurrentFrame++;
+	// The last bucket frame we're ticking components up to.
+	const uint64 LastFrame = BucketToTick.CurrentFrame + StepCount - 1;
+
+	const uint64 BucketStartCycles = FPlatformTime::Cycles64();
+	TickBucketRange(BucketToTick, LastFrame, 0, ComponentCount);
+	BucketToTick.LastTickMS = static_cast<float>(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - BucketStartCycles));
 
-	IncrementTickCounter();
+	FinishBucketTick(BucketIndex, StepCount);
 }
 
-void UAdaGameplayStateManager::IncrementAssignmentCounter()
+void UAdaGameplayStateManager::TickBucketRange(FTickBucket& BucketToTick, const uint64 LastFrame, const int32 StartIndex, const int32 EndIndex)
 {
-	NextBucketToAssign = (NextBucketToAssign < ADA_TICK_BUCKET_COUNT - 1) ? NextBucketToAssign + 1 : 0;
+	TGuardValue<bool> TickingGuard(bIsTickingBucket, true);
+
+	if (bTickBucketsInParallel && FApp::ShouldUseThreadingForPerformance() && EndIndex - StartIndex > MinComponentsPerParallelTask)
+	{
+		TickBucketInParallel(BucketToTick, LastFrame, StartIndex, EndIndex);
+		return;
+	}
+
+	for (int32 Index = StartIndex; Index < EndIndex; Index++)
+	{
+		FTickBucketEntry& EntryToTick = BucketToTick.Components[Index];
+		UAdaGameplayStateComponent* ComponentToTick = EntryToTick.Component.Get();
+		if (!IsValid(ComponentToTick))
+		{
+			continue;
+		}
+
+		const uint32 PendingSteps = ConsumePendingSteps(EntryToTick, LastFrame);
+		if (PendingSteps == 0)
+		{
+			continue;
+		}
+
+		const float CostMS = TickStateComponent(ComponentToTick, LastFrame, PendingSteps);
+
+		// The entry array may have grown while ticking, so look the entry up again.
+		RecordComponentCost(BucketToTick.Components[Index], CostMS);
+	}
 }
 
-void UAdaGameplayStateManager::IncrementTickCounter()
+void UAdaGameplayStateManager::TickBucketInParallel(FTickBucket& BucketToTick, const uint64 LastFrame, const int32 StartIndex, const int32 EndIndex)
 {
-	NextBucketToTick = (NextBucketToTick < ADA_TICK_BUCKET_COUNT - 1) ? NextBucketToTick + 1 : 0;
+	TArray<FComponentTickItem> Items;
+	GatherDueComponents(BucketToTick, LastFrame, StartIndex, EndIndex, Items);
+	TickGameThreadItems(Items, LastFrame);
+
+	ParallelFor(TEXT("AdaGameplayStateManager::TickBucket"), Items.Num(), 1, [&Items, LastFrame](const int32 ItemIndex)
+	{
+		FComponentTickItem& Item = Items[ItemIndex];
+		if (!Item.bGameThread)
+		{
+			Item.CostMS = TickStateComponent(Item.Component, LastFrame, Item.PendingSteps);
+		}
+	});
+
+	FlushTickedComponents(BucketToTick, Items);
 }
 
-void UAdaGameplayStateManager::OnStatusEffectDefsLoaded()
+void UAdaGameplayStateManager::LaunchPipelinedBucketTick(const uint8 BucketIndex, const uint32 StepCount)
 {
-	UAssetManager& AssetManager = UAssetManager::Get();
-	TArray<UObject*> LoadedObjects;
-	AssetManager.GetPrimaryAssetObjectList(UAdaStatusEffectDefinition::PrimaryAssetType, LoadedObjects);
-	for (const UObject* const LoadedObject : LoadedObjects)
+	FTickBucket& BucketToTick = TickBuckets[BucketIndex];
+	const uint64 LastFrame = BucketToTick.CurrentFrame + StepCount - 1;
+
+	TArray<FComponentTickItem> Items;
+	GatherDueComponents(BucketToTick, LastFrame, 0, BucketToTick.Components.Num(), Items);
+
+	// Ticking these can reach back into here to complete other pipelined ticks, so they have to be done before this one is added.
+	TickGameThreadItems(Items, LastFrame);
+
+	FPipelinedBucketTick& PipelinedTick = PipelinedBucketTicks.AddDefaulted_GetRef();
+	PipelinedTick.BucketIndex = BucketIndex;
+	PipelinedTick.StepCount = StepCount;
+	PipelinedTick.Items = MoveTemp(Items);
+
+	for (const FComponentTickItem& Item : PipelinedTick.Items)
+	{
+		// Until we've been joined, the game thread has to wait for us before it can touch this component.
+		if (!Item.bGameThread)
+		{
+			Item.Component->PipelinedTickOwner = this;
+		}
+	}
+
+	// Nothing touches the item array again until the task has been joined, so its allocation stays put even if more ticks are launched.
+	const TArrayView<FComponentTickItem> TaskItems = PipelinedTick.Items;
+	const bool bInParallel = bTickBucketsInParallel && TaskItems.Num() > MinComponentsPerParallelTask;
+	PipelinedTick.Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, [TaskItems, LastFrame, bInParallel]()
 	{
-		if (const UAdaStatusEffectDefinition* const LoadedStatusEffect = Cast<UAdaStatusEffectDefinition>(LoadedObject))
+		TGuardValue<bool> RunningGuard(bIsRunningPipelinedTickOnThisThread, true);
+
+		ParallelFor(TEXT("AdaGameplayStateManager::PipelinedTickBucket"), TaskItems.Num(), 1, [TaskItems, LastFrame](const int32 ItemIndex)
+		{
+			FComponentTickItem& Item = TaskItems[ItemIndex];
+			if (!Item.bGameThread)
+			{
+				Item.CostMS = TickStateComponent(Item.Component, LastFrame, Item.PendingSteps);
+			}
+		}, bInParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+	});
+}
+
+void UAdaGameplayStateManager::CompletePipelinedTicks()
+{
+	if (PipelinedBucketTicks.IsEmpty())
+	{
+		return;
+	}
+
+	A_ENSURE_MSG_RET(IsInGameThread() && !IsRunningPipelinedTick(), void(), TEXT("%hs: Pipelined bucket ticks can only be completed from the game thread."), __FUNCTION__);
+
+	for (const FPipelinedBucketTick& PipelinedTick : PipelinedBucketTicks)
+	{
+		PipelinedTick.Task.Wait();
+	}
+
+	// Broadcasts can reach back into components, and so back in here, so every component needs to be released before any of them broadcast.
+	TArray<FPipelinedBucketTick> CompletedTicks = MoveTemp(PipelinedBucketTicks);
+	for (const FPipelinedBucketTick& PipelinedTick : CompletedTicks)
+	{
+		for (const FComponentTickItem& Item : PipelinedTick.Items)
+		{
+			Item.Component->PipelinedTickOwner = nullptr;
+		}
+	}
+
+	for (const FPipelinedBucketTick& PipelinedTick : CompletedTicks)
+	{
+		FTickBucket& BucketToTick = TickBuckets[PipelinedTick.BucketIndex];
+		{
+			TGuardValue<bool> TickingGuard(bIsTickingBucket, true);
+			FlushTickedComponents(BucketToTick, PipelinedTick.Items);
+		}
+
+		BucketToTick.LastTickMS = 0.0f;
+		for (const FComponentTickItem& Item : PipelinedTick.Items)
+		{
+			BucketToTick.LastTickMS += Item.CostMS;
+		}
+
+		FinishBucketTick(PipelinedTick.BucketIndex, PipelinedTick.StepCount);
+	}
+
+	FinishPendingRound();
+}
+
+void UAdaGameplayStateManager::TickSpreadBuckets(const float DeltaSeconds)
+{
+	if (SpreadBucketTicks.IsEmpty())
+	{
+		return;
+	}
+
+	const UWorld* const World = GetWorld();
+	A_VALIDATE_OBJ(World, void());
+
+	const UAdaTickManager* const TickManager = World->GetSubsystem<UAdaTickManager>();
+	A_VALIDATE_OBJ(TickManager, void());
+
+	int32 RemainingComponents = 0;
+	for (const FSpreadBucketTick& SpreadTick : SpreadBucketTicks)
+	{
+		RemainingComponents += SpreadTick.EndIndex - SpreadTick.NextIndex;
+	}
+
+	// Assuming the next few engine frames take as long as this one, this is how many we have left, this one included,
+	// before the next step finishes off whatever is left over. Splitting the remaining work evenly between them keeps the cost per frame flat.
+	const float DeltaMS = FMath::Max(DeltaSeconds * 1000.0f, KINDA_SMALL_NUMBER);
+	const int32 FramesUntilNextStep = FMath::Max(FMath::CeilToInt32(TickManager->GetTimeUntilNextStepMS() / DeltaMS), 1);
+
+	TickSpreadBucketComponents(FMath::DivideAndRoundUp(RemainingComponents, FramesUntilNextStep));
+}
+
+void UAdaGameplayStateManager::CompleteSpreadBucketTicks()
+{
+	TickSpreadBucketComponents(MAX_int32);
+}
+
+void UAdaGameplayStateManager::TickSpreadBucketComponents(int32 ComponentBudget)
+{
+	// Buckets are always finished in the order they were started, and each bucket in entry order, so the order components
+	// are ticked in doesn't depend on how the work happened to be split between engine frames.
+	while (!SpreadBucketTicks.IsEmpty() && ComponentBudget > 0)
+	{
+		FSpreadBucketTick& SpreadTick = SpreadBucketTicks[0];
+		FTickBucket& BucketToTick = TickBuckets[SpreadTick.BucketIndex];
+
+		// Every component is ticked up to the same frame, whichever engine frame it lands on.
+		const uint64 LastFrame = BucketToTick.CurrentFrame + SpreadTick.StepCount - 1;
+		const int32 EndIndex = SpreadTick.NextIndex + FMath::Min(ComponentBudget, SpreadTick.EndIndex - SpreadTick.NextIndex);
+
+		const uint64 SliceStartCycles = FPlatformTime::Cycles64();
+		TickBucketRange(BucketToTick, LastFrame, SpreadTick.NextIndex, EndIndex);
+
+		// Ticking may have reached back in here, so look the spread tick up again.
+		FSpreadBucketTick& UpdatedSpreadTick = SpreadBucketTicks[0];
+		UpdatedSpreadTick.ElapsedMS += static_cast<float>(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - SliceStartCycles));
+		ComponentBudget -= EndIndex - UpdatedSpreadTick.NextIndex;
+		UpdatedSpreadTick.NextIndex = EndIndex;
+
+		if (UpdatedSpreadTick.NextIndex >= UpdatedSpreadTick.EndIndex)
+		{
+			const FSpreadBucketTick FinishedTick = UpdatedSpreadTick;
+			SpreadBucketTicks.RemoveAt(0, 1, EAllowShrinking::No);
+
+			BucketToTick.LastTickMS = FinishedTick.ElapsedMS;
+			FinishBucketTick(FinishedTick.BucketIndex, FinishedTick.StepCount);
+		}
+	}
+
+	FinishPendingRound();
+}
+
+bool UAdaGameplayStateManager::HasBucketTicksInFlight() const
+{
+	return !PipelinedBucketTicks.IsEmpty() || !SpreadBucketTicks.IsEmpty();
+}
+
+void UAdaGameplayStateManager::FinishPendingRound()
+{
+	if (bRoundFinishPending && !HasBucketTicksInFlight())
+	{
+		bRoundFinishPending = false;
+		OnRoundFinished();
+	}
+}
+
+bool UAdaGameplayStateManager::IsRunningPipelinedTick()
+{
+	return bIsRunningPipelinedTickOnThisThread;
+}
+
+void UAdaGameplayStateManager::GatherDueComponents(FTickBucket& BucketToTick, const uint64 LastFrame, const int32 StartIndex, const int32 EndIndex, TArray<FComponentTickItem>& OutItems)
+{
+	OutItems.Reserve(EndIndex - StartIndex);
+
+	for (int32 Index = StartIndex; Index < EndIndex; Index++)
+	{
+		FTickBucketEntry& EntryToTick = BucketToTick.Components[Index];
+		UAdaGameplayStateComponent* ComponentToTick = EntryToTick.Component.Get();
+		if (!IsValid(ComponentToTick))
+		{
+			continue;
+		}
+
+		const uint32 PendingSteps = ConsumePendingSteps(EntryToTick, LastFrame);
+		if (PendingSteps == 0)
+		{
+			continue;
+		}
+
+		// Components don't share attribute or modifier storage, and each status effect belongs to a single component, so other than
+		// broadcasting, the only thing they can't do off the game thread is call into Blueprint or delegates that aren't thread safe.
+		// Those components are ticked on the game thread, but still hold on to their broadcasts so that everything goes out in bucket order.
+		ComponentToTick->bDeferNotifications = true;
+		OutItems.Add({ComponentToTick, Index, PendingSteps, 0.0f, ComponentToTick->RequiresGameThreadTick()});
+	}
+}
+
+void UAdaGameplayStateManager::TickGameThreadItems(TArrayView<FComponentTickItem> Items, const uint64 LastFrame)
+{
+	// These go before anything is handed off, so that nothing they call into runs alongside components being ticked elsewhere.
+	TGuardValue<bool> TickingGuard(bIsTickingBucket, true);
+
+	for (FComponentTickItem& Item : Items)
+	{
+		if (Item.bGameThread)
+		{
+			Item.CostMS = TickStateComponent(Item.Component, LastFrame, Item.PendingSteps);
+		}
+	}
+}
+
+void UAdaGameplayStateManager::FlushTickedComponents(FTickBucket& BucketToTick, const TArray<FComponentTickItem>& Items)
+{
+	// Replay broadcasts on this thread in bucket order, so that subscribers always see them in the same order.
+	for (const FComponentTickItem& Item : Items)
+	{
+		Item.Component->bDeferNotifications = false;
+		Item.Component->FlushDeferredNotifications();
+
+		RecordComponentCost(BucketToTick.Components[Item.EntryIndex], Item.CostMS);
+	}
+}
+
+void UAdaGameplayStateManager::FinishBucketTick(const uint8 BucketIndex, const uint32 StepCount)
+{
+	FTickBucket& BucketToTick = TickBuckets[BucketIndex];
+	BucketToTick.CurrentFrame += StepCount;
+
+	// Clean up any components that were unregistered or destroyed, put any that have gone idle to sleep, and recalculate the bucket's load.
+	BucketToTick.LoadMS = 0.0f;
+	for (int32 Index = BucketToTick.Components.Num() - 1; Index >= 0; Index--)
+	{
+		FTickBucketEntry& Entry = BucketToTick.Components[Index];
+		UAdaGameplayStateComponent* const Component = Entry.Component.Get();
+		if (!IsValid(Component))
+		{
+			if (const uint8* const FoundBucket = ComponentToBucketMap.Find(Entry.ComponentKey); FoundBucket && *FoundBucket == BucketIndex)
+			{
+				ComponentToBucketMap.Remove(Entry.ComponentKey);
+			}
+
+			BucketToTick.Components.RemoveAtSwap(Index, EAllowShrinking::No);
+			continue;
+		}
+
+		if (bAllowComponentsToSleep && Component->bReadyToSleep)
+		{
+			Component->bReadyToSleep = false;
+			Component->bIsAsleep = true;
+			SleepingEntries.Add(Entry.ComponentKey, MoveTemp(Entry));
+			BucketToTick.Components.RemoveAtSwap(Index, EAllowShrinking::No);
+			continue;
+		}
+
+		BucketToTick.LoadMS += Entry.GetEffectiveCostMS();
+	}
+}
+
+uint32 UAdaGameplayStateManager::ConsumePendingSteps(FTickBucketEntry& Entry, const uint64 LastFrame)
+{
+	// Components in lower tiers let frames build up until they're due, then catch up on all of them at once.
+	const uint32 PendingSteps = static_cast<uint32>(FMath::Min<uint64>(LastFrame + 1 - FMath::Min(Entry.NextFrame, LastFrame + 1), MAX_uint32));
+	if (PendingSteps == 0 || PendingSteps < GetTickTierRateDivisor(Entry.Tier))
+	{
+		return 0;
+	}
+
+	Entry.NextFrame = LastFrame + 1;
+	return PendingSteps;
+}
+
+float UAdaGameplayStateManager::TickStateComponent(UAdaGameplayStateComponent* const Component, const uint64 LastFrame, const uint32 PendingSteps)
+{
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	if (PendingSteps == 1)
+	{
+		Component->FixedTick(LastFrame);
+	}
+	else
+	{
+		Component->FixedTick(LastFrame, PendingSteps);
+	}
+
+	return static_cast<float>(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles));
+}
+
+void UAdaGameplayStateManager::RecordComponentCost(FTickBucketEntry& Entry, const float CostMS)
+{
+	Entry.CostMS = Entry.bHasMeasuredCost ? FMath::Lerp(Entry.CostMS, CostMS, ComponentCostSmoothing) : CostMS;
+	Entry.bHasMeasuredCost = true;
+}
+
+void UAdaGameplayStateManager::IncrementTickCounter()
+{
+	NextBucketToTick = (NextBucketToTick < TickBuckets.Num() - 1) ? NextBucketToTick + 1 : 0;
+}
+
+void UAdaGameplayStateManager::RebalanceBuckets()
+{
+	// Relearn the cost of a unit of work from everything we've measured, so new components get a sensible estimate.
+	float MeasuredCostMS = 0.0f;
+	int32 MeasuredWork = 0;
+	for (const FTickBucket& Bucket : TickBuckets)
+	{
+		for (const FTickBucketEntry& Entry : Bucket.Components)
+		{
+			const UAdaGameplayStateComponent* const Component = Entry.Component.Get();
+			if (Entry.bHasMeasuredCost && IsValid(Component))
+			{
+				MeasuredCostMS += Entry.CostMS;
+				MeasuredWork += Component->GetTickWorkEstimate();
+			}
+		}
+	}
+
+	if (MeasuredWork > 0)
+	{
+		CostPerWorkUnitMS = MeasuredCostMS / MeasuredWork;
+	}
+
+	for (int32 Migration = 0; Migration < MaxBucketMigrationsPerRound; Migration++)
+	{
+		uint8 MostLoadedIndex = 0;
+		uint8 LeastLoadedIndex = 0;
+		for (uint8 BucketIndex = 1; BucketIndex < TickBuckets.Num(); BucketIndex++)
+		{
+			MostLoadedIndex = TickBuckets[BucketIndex].LoadMS > TickBuckets[MostLoadedIndex].LoadMS ? BucketIndex : MostLoadedIndex;
+			LeastLoadedIndex = TickBuckets[BucketIndex].LoadMS < TickBuckets[LeastLoadedIndex].LoadMS ? BucketIndex : LeastLoadedIndex;
+		}
+
+		FTickBucket& MostLoaded = TickBuckets[MostLoadedIndex];
+		FTickBucket& LeastLoaded = TickBuckets[LeastLoadedIndex];
+
+		const float Imbalance = MostLoaded.LoadMS - LeastLoaded.LoadMS;
+		if (MostLoadedIndex == LeastLoadedIndex || Imbalance <= LeastLoaded.LoadMS * BucketImbalanceThreshold || Imbalance <= KINDA_SMALL_NUMBER)
+		{
+			return;
+		}
+
+		// Moving the component closest to half the imbalance gets both buckets closest to even, without overshooting.
+		const float TargetCostMS = Imbalance * 0.5f;
+		int32 BestEntryIndex = INDEX_NONE;
+		float BestCostMS = 0.0f;
+		for (int32 EntryIndex = 0; EntryIndex < MostLoaded.Components.Num(); EntryIndex++)
+		{
+			const float CostMS = MostLoaded.Components[EntryIndex].GetEffectiveCostMS();
+			if (CostMS > 0.0f && CostMS < Imbalance && (BestEntryIndex == INDEX_NONE || FMath::Abs(CostMS - TargetCostMS) < FMath::Abs(BestCostMS - TargetCostMS)))
+			{
+				BestEntryIndex = EntryIndex;
+				BestCostMS = CostMS;
+			}
+		}
+
+		if (BestEntryIndex == INDEX_NONE)
+		{
+			return;
+		}
+
+		// Every bucket is on the same frame between rounds, so the component neither skips nor repeats any of its ticks.
+		const FTickBucketEntry Entry = MostLoaded.Components[BestEntryIndex];
+		MostLoaded.Components.RemoveAtSwap(BestEntryIndex, EAllowShrinking::No);
+		MostLoaded.LoadMS -= BestCostMS;
+
+		LeastLoaded.Components.Add(Entry);
+		LeastLoaded.LoadMS += BestCostMS;
+
+		ComponentToBucketMap.Add(Entry.ComponentKey, LeastLoadedIndex);
+	}
+}
+
+uint8 UAdaGameplayStateManager::FindLeastLoadedBucket() const
+{
+	uint8 LeastLoadedIndex = 0;
+	for (uint8 BucketIndex = 1; BucketIndex < TickBuckets.Num(); BucketIndex++)
+	{
+		const FTickBucket& Bucket = TickBuckets[BucketIndex];
+		const FTickBucket& LeastLoaded = TickBuckets[LeastLoadedIndex];
+		if (Bucket.LoadMS < LeastLoaded.LoadMS || (Bucket.LoadMS == LeastLoaded.LoadMS && Bucket.Components.Num() < LeastLoaded.Components.Num()))
+		{
+			LeastLoadedIndex = BucketIndex;
+		}
+	}
+
+	return LeastLoadedIndex;
+}
+
+void UAdaGameplayStateManager::UpdateTickTiers()
+{
+	if (!TickTierScorer.IsBound())
+	{
+		return;
+	}
+
+	for (FTickBucket& Bucket : TickBuckets)
+	{
+		Bucket.LoadMS = 0.0f;
+		for (FTickBucketEntry& Entry : Bucket.Components)
+		{
+			if (const UAdaGameplayStateComponent* const Component = Entry.Component.Get(); IsValid(Component))
+			{
+				Entry.Tier = TickTierScorer.Execute(Component);
+			}
+
+			Bucket.LoadMS += Entry.GetEffectiveCostMS();
+		}
+	}
+}
+
+void UAdaGameplayStateManager::SetTickTierScorer(const FAdaGameplayStateTickTierScorer& InScorer)
+{
+	TickTierScorer = InScorer;
+	RoundsSinceTickTierUpdate = 0;
+	UpdateTickTiers();
+}
+
+void UAdaGameplayStateManager::SetComponentTickTier(const UAdaGameplayStateComponent* StateComponent, const EAdaGameplayStateTickTier Tier)
+{
+	A_VALIDATE_OBJ(StateComponent, void());
+
+	if (FTickBucketEntry* const SleepingEntry = SleepingEntries.Find(StateComponent))
+	{
+		SleepingEntry->Tier = Tier;
+		return;
+	}
+
+	FTickBucketEntry* const Entry = FindEntry(StateComponent);
+	A_ENSURE_MSG_RET(Entry, void(), TEXT("%hs: Component %s isn't registered with the gameplay state manager."), __FUNCTION__, *GetNameSafe(StateComponent));
+
+	FTickBucket& Bucket = TickBuckets[ComponentToBucketMap.FindChecked(StateComponent)];
+	Bucket.LoadMS -= Entry->GetEffectiveCostMS();
+	Entry->Tier = Tier;
+	Bucket.LoadMS += Entry->GetEffectiveCostMS();
+}
+
+EAdaGameplayStateTickTier UAdaGameplayStateManager::GetComponentTickTier(const UAdaGameplayStateComponent* StateComponent) const
+{
+	const uint8* const FoundBucket = ComponentToBucketMap.Find(StateComponent);
+	if (!FoundBucket)
+	{
+		return EAdaGameplayStateTickTier::Full;
+	}
+
+	if (const FTickBucketEntry* const SleepingEntry = SleepingEntries.Find(StateComponent))
+	{
+		return SleepingEntry->Tier;
+	}
+
+	const FTickBucketEntry* const Entry = TickBuckets[*FoundBucket].Components.FindByPredicate([StateComponent](const FTickBucketEntry& Entry) { return Entry.Component == StateComponent; });
+	return Entry ? Entry->Tier : EAdaGameplayStateTickTier::Full;
+}
+
+UAdaGameplayStateManager::FTickBucketEntry* UAdaGameplayStateManager::FindEntry(const UAdaGameplayStateComponent* StateComponent)
+{
+	const uint8* const FoundBucket = ComponentToBucketMap.Find(StateComponent);
+	if (!FoundBucket)
+	{
+		return nullptr;
+	}
+
+	return TickBuckets[*FoundBucket].Components.FindByPredicate([StateComponent](const FTickBucketEntry& Entry) { return Entry.Component == StateComponent; });
+}
+
+float UAdaGameplayStateManager::FTickBucketEntry::GetEffectiveCostMS() const
+{
+	return Tier == EAdaGameplayStateTickTier::Dormant ? 0.0f : CostMS / GetTickTierRateDivisor(Tier);
+}
+
+int32 UAdaGameplayStateManager::GetDesiredTickBucketCount()
+{
+	const int32 OverrideCount = CVarTickBucketCount.GetValueOnGameThread();
+	if (OverrideCount > 0)
+	{
+		return FMath::Min<int32>(OverrideCount, MAX_uint8);
+	}
+
+	const UAdaGameplayStateSettings* const Settings = GetDefault<UAdaGameplayStateSettings>();
+	return IsValid(Settings) ? FMath::Clamp<int32>(Settings->TickBucketCount, 1, MAX_uint8) : 15;
+}
+
+void UAdaGameplayStateManager::ResizeTickBuckets(const int32 NewBucketCount)
+{
+	A_ENSURE_RET(!bIsTickingBucket, void());
+	A_ENSURE_RET(NewBucketCount > 0 && NewBucketCount <= MAX_uint8, void());
+
+	const int32 OldBucketCount = TickBuckets.Num();
+	if (NewBucketCount == OldBucketCount || OldBucketCount == 0)
+	{
+		TickBuckets.SetNum(NewBucketCount);
+		return;
+	}
+
+	// Each bucket frame lasts as many fixed steps as there are buckets, so rescale frames to keep them in step with simulation time.
+	const double Scale = static_cast<double>(OldBucketCount) / NewBucketCount;
+	const uint64 OldFrame = TickBuckets[0].CurrentFrame;
+	const uint64 NewFrame = static_cast<uint64>(FMath::RoundToInt64(OldFrame * Scale));
+
+	TArray<FTickBucketEntry> Entries;
+	Entries.Reserve(ComponentToBucketMap.Num());
+	for (FTickBucket& Bucket : TickBuckets)
+	{
+		for (FTickBucketEntry& Entry : Bucket.Components)
+		{
+			if (Entry.Component.IsValid())
+			{
+				Entries.Add(MoveTemp(Entry));
+			}
+		}
+	}
+
+	// Hand out the most expensive components first, each to the least loaded bucket, which keeps the new buckets close to even.
+	Entries.Sort([](const FTickBucketEntry& A, const FTickBucketEntry& B)
+	{
+		return A.GetEffectiveCostMS() > B.GetEffectiveCostMS();
+	});
+
+	TickBuckets.Reset(NewBucketCount);
+	TickBuckets.SetNum(NewBucketCount);
+	for (FTickBucket& Bucket : TickBuckets)
+	{
+		Bucket.CurrentFrame = NewFrame;
+	}
+
+	ComponentToBucketMap.Reset();
+	NextBucketToTick = 0;
+
+	for (FTickBucketEntry& Entry : Entries)
+	{
+		Entry.NextFrame = FAdaAttributeModifier::RescaleTick(Entry.NextFrame, OldFrame, NewFrame, Scale);
+		Entry.Component->RescaleTicks(OldFrame, NewFrame, Scale);
+
+		const uint8 BucketIndex = FindLeastLoadedBucket();
+		TickBuckets[BucketIndex].LoadMS += Entry.GetEffectiveCostMS();
+		ComponentToBucketMap.Add(Entry.ComponentKey, BucketIndex);
+		TickBuckets[BucketIndex].Components.Add(MoveTemp(Entry));
+	}
+
+	// Sleeping components cost nothing, so spread them evenly. Their frames are reset when they wake, but their own ticks still need rescaling.
+	int32 SleepingIndex = 0;
+	for (auto It = SleepingEntries.CreateIterator(); It; ++It)
+	{
+		UAdaGameplayStateComponent* const Component = It.Value().Component.Get();
+		if (!IsValid(Component))
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		Component->RescaleTicks(OldFrame, NewFrame, Scale);
+		ComponentToBucketMap.Add(It.Key(), static_cast<uint8>(SleepingIndex++ % NewBucketCount));
+	}
+
+	UE_LOG(LogAdaGameplayStateManager, Log, TEXT("%hs: Resized tick buckets from %i to %i, moving %i components from frame %llu to frame %llu."), __FUNCTION__, OldBucketCount, NewBucketCount, Entries.Num(), OldFrame, NewFrame);
+}
+
+float UAdaGameplayStateManager::EstimateComponentCost(const UAdaGameplayStateComponent* const StateComponent) const
+{
+	return CostPerWorkUnitMS * StateComponent->GetTickWorkEstimate();
+}
+
+void UAdaGameplayStateManager::DumpBucketLoads() const
+{
+	float TotalLoadMS = 0.0f;
+	int32 TierCounts[4] = {};
+	for (const FTickBucket& Bucket : TickBuckets)
+	{
+		TotalLoadMS += Bucket.LoadMS;
+		for (const FTickBucketEntry& Entry : Bucket.Components)
+		{
+			TierCounts[static_cast<uint8>(Entry.Tier)]++;
+		}
+	}
+
+	UE_LOG(LogAdaGameplayStateManager, Display, TEXT("Gameplay state tick buckets (%i components, %.3fms total load):"), ComponentToBucketMap.Num(), TotalLoadMS);
+	UE_LOG(LogAdaGameplayStateManager, Display, TEXT("Tick tiers: %i full, %i half, %i quarter, %i dormant. %i asleep."), TierCounts[0], TierCounts[1], TierCounts[2], TierCounts[3], SleepingEntries.Num());
+	UE_LOG(LogAdaGameplayStateManager, Display, TEXT("%-8s %-12s %10s %10s %12s"), TEXT("Bucket"), TEXT("Components"), TEXT("Load"), TEXT("Last Tick"), TEXT("Frame"));
+
+	for (int32 BucketIndex = 0; BucketIndex < TickBuckets.Num(); BucketIndex++)
+	{
+		const FTickBucket& Bucket = TickBuckets[BucketIndex];
+		UE_LOG(LogAdaGameplayStateManager, Display, TEXT("%-8i %-12i %8.3fms %8.3fms %12llu"), BucketIndex, Bucket.Components.Num(), Bucket.LoadMS, Bucket.LastTickMS, Bucket.CurrentFrame);
+	}
+}
+
+void UAdaGameplayStateManager::GatherPreloadedStatusEffects(TArray<FPrimaryAssetId>& OutAssetIds) const
+{
+	FGameplayTagContainer PreloadTags = PreloadedStatusEffects;
+
+	const UWorld* const World = GetWorld();
+	const UAdaGameplayStateSettings* const Settings = GetDefault<UAdaGameplayStateSettings>();
+	if (IsValid(World) && IsValid(Settings))
+	{
+		// Map preloads are keyed by the map's asset, which doesn't include the prefix PIE adds to its package.
+		const FString MapPackageName = UWorld::RemovePIEPrefix(World->GetOutermost()->GetName());
+		for (const auto& [Map, MapPreloadTags] : Settings->MapStatusEffectPreloads)
+		{
+			if (Map.GetLongPackageName() == MapPackageName)
+			{
+				PreloadTags.AppendTags(MapPreloadTags);
+			}
+		}
+	}
+
+	if (PreloadTags.IsEmpty())
+	{
+		return;
+	}
+
+	// Definitions are identified by their effect tag, so we can match them against the preloads without loading them.
+	TArray<FPrimaryAssetId> AllAssetIds;
+	UAssetManager::Get().GetPrimaryAssetIdList(UAdaStatusEffectDefinition::PrimaryAssetType, AllAssetIds);
+	for (const FPrimaryAssetId& AssetId : AllAssetIds)
+	{
+		const FGameplayTag EffectTag = FGameplayTag::RequestGameplayTag(AssetId.PrimaryAssetName, false);
+		if (EffectTag.MatchesAny(PreloadTags))
+		{
+			OutAssetIds.Add(AssetId);
+		}
+	}
+}
+
+void UAdaGameplayStateManager::OnStatusEffectDefsLoaded()
+{
+	UAssetManager& AssetManager = UAssetManager::Get();
+	TArray<UObject*> LoadedObjects;
+	AssetManager.GetPrimaryAssetObjectList(UAdaStatusEffectDefinition::PrimaryAssetType, LoadedObjects);
+
+	int64 LoadedBytes = 0;
+	int32 LoadedCount = 0;
+	for (UObject* const LoadedObject : LoadedObjects)
+	{
+		UAdaStatusEffectDefinition* const LoadedStatusEffect = Cast<UAdaStatusEffectDefinition>(LoadedObject);
+		if (LoadedStatusEffect && !IsStatusEffectLoaded(LoadedStatusEffect->EffectTag))
+		{
+			LoadedBytes += AddStatusEffectDefinition(*LoadedStatusEffect);
+			LoadedCount++;
+		}
+	}
+
+	const double LoadSeconds = FPlatformTime::Seconds() - PreloadStartTime;
+	StatusEffectLoadCount++;
+	StatusEffectLoadSeconds += LoadSeconds;
+
+	UE_LOG(LogAdaGameplayStateManager, Display, TEXT("%hs: Loaded %i status effect definitions in %.2fms, using %.1fKB."),
+		__FUNCTION__, LoadedCount, LoadSeconds * 1000.0, LoadedBytes / 1024.0);
+}
+
+void UAdaGameplayStateManager::OnStatusEffectDefStreamed(const FGameplayTag EffectTag)
+{
+	FPendingStatusEffectLoad PendingLoad;
+	if (!PendingStatusEffectLoads.RemoveAndCopyValue(EffectTag, PendingLoad))
+	{
+		// We were torn down while it was loading.
+		return;
+	}
+
+	if (!IsStatusEffectLoaded(EffectTag))
+	{
+		const FPrimaryAssetId AssetId(UAdaStatusEffectDefinition::PrimaryAssetType, EffectTag.GetTagName());
+		UAdaStatusEffectDefinition* const Definition = UAssetManager::Get().GetPrimaryAssetObject<UAdaStatusEffectDefinition>(AssetId);
+		if (IsValid(Definition))
+		{
+			const int64 LoadedBytes = AddStatusEffectDefinition(*Definition);
+			StreamedStatusEffects.Add(EffectTag, {FPlatformTime::Seconds(), LoadedBytes});
+
+			const double LoadSeconds = FPlatformTime::Seconds() - PendingLoad.StartTime;
+			StatusEffectLoadCount++;
+			StatusEffectLoadSeconds += LoadSeconds;
+
+			UE_LOG(LogAdaGameplayStateManager, Log, TEXT("%hs: Streamed status effect definition %s in %.2fms, using %.1fKB."),
+				__FUNCTION__, *EffectTag.ToString(), LoadSeconds * 1000.0, LoadedBytes / 1024.0);
+		}
+		else
+		{
+			UE_LOG(LogAdaGameplayStateManager, Error, TEXT("%hs: Failed to stream status effect definition %s."), __FUNCTION__, *EffectTag.ToString());
+		}
+	}
+
+	const bool bLoaded = IsStatusEffectLoaded(EffectTag);
+	for (TUniqueFunction<void(const bool)>& Callback : PendingLoad.Callbacks)
+	{
+		Callback(bLoaded);
+	}
+}
+
+int64 UAdaGameplayStateManager::AddStatusEffectDefinition(UAdaStatusEffectDefinition& Definition)
+{
+	LoadedStatusEffectDefinitions.Add(Definition.EffectTag, &Definition);
+	CompiledStatusEffects.Add(Definition.EffectTag, CompileStatusEffect(Definition));
+
+	const int64 DefinitionBytes = Definition.GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+	LoadedStatusEffectBytes += DefinitionBytes;
+
+	return DefinitionBytes;
+}
+
+TSharedRef<const FAdaCompiledStatusEffect> UAdaGameplayStateManager::CompileStatusEffect(const UAdaStatusEffectDefinition& Definition)
+{
+	TSharedRef<FAdaCompiledStatusEffect> CompiledEffect = MakeShared<FAdaCompiledStatusEffect>();
+	CompiledEffect->EffectTag = Definition.EffectTag;
+	CompiledEffect->TagCategories = Definition.TagCategories;
+	CompiledEffect->Implementation = IsValid(Definition.Implementation) ? Definition.Implementation : TSubclassOf<UAdaStatusEffect>(UAdaStatusEffect::StaticClass());
+	CompiledEffect->StateTagsToAdd = Definition.StateTagsToAdd;
+	CompiledEffect->BlockingTags = Definition.BlockingTags;
+	CompiledEffect->EnablingTags = Definition.EnablingTags;
+	CompiledEffect->bCanStack = Definition.bCanStack;
+	CompiledEffect->EffectsToCancel = Definition.EffectsToCancel;
+	CompiledEffect->EffectTypesToCancel = Definition.EffectTypesToCancel;
+	CompiledEffect->bCancelsEffects = !Definition.EffectsToCancel.IsEmpty() || !Definition.EffectTypesToCancel.IsEmpty();
+
+	CompiledEffect->Modifiers.Reserve(Definition.Modifiers.Num());
+	for (const auto& [AttributeTag, ModifierSpec] : Definition.Modifiers)
+	{
+		// Validate as the editor would, since effect delegates can't be bound until the effect is applied.
+		TArray<FString> Errors;
+		if (!UAdaAttributeFunctionLibrary::IsModifierValid(ModifierSpec, Errors, true))
+		{
+			UE_LOG(LogAdaGameplayStateManager, Error, TEXT("%hs: Dropping invalid modifier to attribute %s from status effect %s:"), __FUNCTION__, *AttributeTag.ToString(), *Definition.EffectTag.ToString());
+			for (const FString& ErrorString : Errors)
+			{
+				UE_LOG(LogAdaGameplayStateManager, Error, TEXT("%hs: %s"), __FUNCTION__, *ErrorString);
+			}
+
+			continue;
+		}
+
+		FAdaCompiledStatusEffectModifier& CompiledModifier = CompiledEffect->Modifiers.AddDefaulted_GetRef();
+		CompiledModifier.AttributeTag = AttributeTag;
+		CompiledModifier.ModifierSpec = ModifierSpec;
+
+		if (ModifierSpec.CalculationType == EAdaAttributeModCalcType::SetByData)
 		{
-			LoadedStatusEffectDefinitions.Add(LoadedStatusEffect->EffectTag, LoadedStatusEffect);
+			CompiledModifier.ModifierCurve = GetBakedCurveForModifier(ModifierSpec.ModifierCurveTag);
 		}
 	}
 
-	UE_LOG(LogAdaGameplayStateManager, Display, TEXT("%hs: Loaded %i status effect definitions."), __FUNCTION__, LoadedStatusEffectDefinitions.Num());
+	return CompiledEffect;
 }
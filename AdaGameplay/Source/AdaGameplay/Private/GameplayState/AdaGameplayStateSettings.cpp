@@ -0,0 +1,5 @@
+// Copyright Matt Bramah-Taylor, 2025. All Rights Reserved.
+
+#include "GameplayState/AdaGameplayStateSettings.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AdaGameplayStateSettings)
\ No newline at end of file
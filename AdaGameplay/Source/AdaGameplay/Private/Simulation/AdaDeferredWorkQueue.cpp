@@ -0,0 +1,168 @@
+// Copyright Matt Bramah-Taylor, 2025. All Rights Reserved.
+
+#include "Simulation/AdaDeferredWorkQueue.h"
+
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Debug/AdaAssertionMacros.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(AdaDeferredWorkQueue)
+
+FAdaDeferredWorkHandle FAdaDeferredWorkQueue::Submit(FAdaDeferredWork&& Work, const EAdaDeferredWorkPriority Priority, const UObject* const Owner, const uint64 CurrentFrame)
+{
+	A_ENSURE_RET(Work, FAdaDeferredWorkHandle());
+	A_ENSURE_RET(Priority < EAdaDeferredWorkPriority::Count, FAdaDeferredWorkHandle());
+
+	const FAdaDeferredWorkHandle NewHandle = ReserveHandle();
+	Submit(MoveTemp(Work), Priority, Owner, CurrentFrame, NewHandle);
+	return NewHandle;
+}
+
+void FAdaDeferredWorkQueue::Submit(FAdaDeferredWork&& Work, const EAdaDeferredWorkPriority Priority, const UObject* const Owner, const uint64 CurrentFrame, const FAdaDeferredWorkHandle& ReservedHandle)
+{
+	A_ENSURE_RET(Work, void());
+	A_ENSURE_RET(Priority < EAdaDeferredWorkPriority::Count, void());
+	A_ENSURE_RET(ReservedHandle.IsValid(), void());
+
+	FWorkItem& NewItem = Queues[static_cast<uint8>(Priority)].Emplace();
+	NewItem.Work = MoveTemp(Work);
+	NewItem.Owner = Owner;
+	NewItem.bHasOwner = Owner != nullptr;
+	NewItem.Identifier = ReservedHandle.Identifier;
+	NewItem.SubmitFrame = CurrentFrame;
+	NewItem.SubmitSeconds = FPlatformTime::Seconds();
+
+	Stats.QueueDepths[static_cast<uint8>(Priority)]++;
+}
+
+FAdaDeferredWorkHandle FAdaDeferredWorkQueue::ReserveHandle()
+{
+	FAdaDeferredWorkHandle NewHandle;
+	NewHandle.Identifier = ++LatestIdentifier;
+	return NewHandle;
+}
+
+void FAdaDeferredWorkQueue::Cancel(FAdaDeferredWorkHandle& Handle)
+{
+	if (!Handle.IsValid())
+	{
+		return;
+	}
+
+	// We don't know whether the work is still queued without searching for it, so look for it in each queue.
+	// Cancellation should be rare compared to submission, and this saves us from keeping a separate lookup up to date.
+	for (const TRingBuffer<FWorkItem>& Queue : Queues)
+	{
+		for (const FWorkItem& Item : Queue)
+		{
+			if (Item.Identifier == Handle.Identifier)
+			{
+				CancelledIdentifiers.Add(Handle.Identifier);
+				Handle.Invalidate();
+				return;
+			}
+		}
+	}
+
+	Handle.Invalidate();
+}
+
+void FAdaDeferredWorkQueue::Drain(const uint64 CurrentFrame, const float BudgetMS)
+{
+	if (Num() == 0)
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(FAdaDeferredWorkQueue::Drain);
+
+	FAdaDeferredWorkContext Context;
+	Context.CurrentFrame = CurrentFrame;
+	Context.DeadlineSeconds = FPlatformTime::Seconds() + BudgetMS / 1000.0;
+
+	// Always run at least one work item so that the queue keeps moving, even if a single item exceeds the budget.
+	bool bHasRunWork = false;
+
+	for (uint8 PriorityIndex = 0; PriorityIndex < static_cast<uint8>(EAdaDeferredWorkPriority::Count); PriorityIndex++)
+	{
+		TRingBuffer<FWorkItem>& Queue = Queues[PriorityIndex];
+
+		// Only visit each item once per step, so that unfinished items sent to the back of the queue aren't run again straight away.
+		int32 RemainingVisits = Queue.Num();
+		while (RemainingVisits-- > 0 && (!bHasRunWork || !Context.ShouldYield()))
+		{
+			FWorkItem Item = Queue.PopFrontValue();
+			Stats.QueueDepths[PriorityIndex]--;
+
+			if (CancelledIdentifiers.Remove(Item.Identifier) > 0)
+			{
+				Stats.CancelledCount++;
+				continue;
+			}
+
+			// Work whose owner has gone away has nothing left to work on.
+			if (Item.bHasOwner && !Item.Owner.IsValid())
+			{
+				Stats.CancelledCount++;
+				continue;
+			}
+
+			bHasRunWork = true;
+			if (Item.Work(Context))
+			{
+				RecordCompletion(Item, CurrentFrame);
+			}
+			else
+			{
+				Queue.Emplace(MoveTemp(Item));
+				Stats.QueueDepths[PriorityIndex]++;
+			}
+		}
+
+		if (bHasRunWork && Context.ShouldYield())
+		{
+			break;
+		}
+	}
+}
+
+void FAdaDeferredWorkQueue::Reset()
+{
+	for (TRingBuffer<FWorkItem>& Queue : Queues)
+	{
+		Queue.Empty();
+	}
+
+	CancelledIdentifiers.Empty();
+
+	for (int32& QueueDepth : Stats.QueueDepths)
+	{
+		QueueDepth = 0;
+	}
+}
+
+int32 FAdaDeferredWorkQueue::Num() const
+{
+	int32 Count = 0;
+	for (const int32 QueueDepth : Stats.QueueDepths)
+	{
+		Count += QueueDepth;
+	}
+
+	return Count;
+}
+
+void FAdaDeferredWorkQueue::RecordCompletion(const FWorkItem& Item, const uint64 CurrentFrame)
+{
+	const double LatencyMS = (FPlatformTime::Seconds() - Item.SubmitSeconds) * 1000.0;
+	const uint64 LatencySteps = CurrentFrame - Item.SubmitFrame;
+
+	Stats.CompletedCount++;
+
+	TotalLatencyMS += LatencyMS;
+	TotalLatencySteps += LatencySteps;
+
+	Stats.MeanLatencyMS = TotalLatencyMS / Stats.CompletedCount;
+	Stats.MaxLatencyMS = FMath::Max(Stats.MaxLatencyMS, LatencyMS);
+	Stats.MeanLatencySteps = static_cast<double>(TotalLatencySteps) / Stats.CompletedCount;
+	Stats.MaxLatencySteps = FMath::Max(Stats.MaxLatencySteps, LatencySteps);
+}
@@ -0,0 +1,97 @@
+// Copyright Matt Bramah-Taylor, 2025. All Rights Reserved.
+
+#include "Simulation/AdaSimulationThread.h"
+
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/RunnableThread.h"
+#include "Simulation/AdaTickManager.h"
+
+FAdaSimulationThread::FAdaSimulationThread(UAdaTickManager* const InTickManager, const double InFixedStepSeconds, const uint8 InMaxCarriedSteps)
+	: TickManager(InTickManager)
+	, FixedStepSeconds(InFixedStepSeconds)
+	, MaxCarriedSteps(InMaxCarriedSteps)
+{
+	WakeEvent = FPlatformProcess::GetSynchEventFromPool();
+}
+
+FAdaSimulationThread::~FAdaSimulationThread()
+{
+	Shutdown();
+
+	FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	WakeEvent = nullptr;
+}
+
+bool FAdaSimulationThread::Start()
+{
+	if (Thread != nullptr || !FPlatformProcess::SupportsMultithreading())
+	{
+		return false;
+	}
+
+	bStopping = false;
+	Thread = FRunnableThread::Create(this, TEXT("AdaSimulationThread"), 0, TPri_AboveNormal);
+	return Thread != nullptr;
+}
+
+void FAdaSimulationThread::Shutdown()
+{
+	if (Thread != nullptr)
+	{
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+}
+
+uint32 FAdaSimulationThread::Run()
+{
+	double StepSeconds = FPlatformTime::Seconds() + FixedStepSeconds;
+	NextStepSeconds = StepSeconds;
+
+	while (!bStopping)
+	{
+		const double NowSeconds = FPlatformTime::Seconds();
+		if (NowSeconds < StepSeconds)
+		{
+			// Round up, as waiting for zero milliseconds would spin until the step is due. Waking a little late is fine, as we
+			// measure from when the step was due rather than when we woke.
+			WakeEvent->Wait(FMath::Max(FMath::CeilToInt32((StepSeconds - NowSeconds) * 1000.0), 1));
+			continue;
+		}
+
+		if (bPaused)
+		{
+			StepSeconds = NowSeconds + FixedStepSeconds;
+			NextStepSeconds = StepSeconds;
+			continue;
+		}
+
+		// If we've fallen further behind than we're willing to carry, drop the steps we can't make up rather than spiralling.
+		const double LagSeconds = NowSeconds - StepSeconds;
+		if (LagSeconds > FixedStepSeconds * (MaxCarriedSteps + 1))
+		{
+			DroppedStepCount += static_cast<uint64>(LagSeconds / FixedStepSeconds);
+			StepSeconds = NowSeconds;
+		}
+
+		TickManager->RunSimulationThreadStep();
+
+		StepSeconds += FixedStepSeconds;
+		NextStepSeconds = StepSeconds;
+	}
+
+	return 0;
+}
+
+float FAdaSimulationThread::GetTimeUntilNextStepMS() const
+{
+	return static_cast<float>(FMath::Max((NextStepSeconds.load(std::memory_order_relaxed) - FPlatformTime::Seconds()) * 1000.0, 0.0));
+}
+
+void FAdaSimulationThread::Stop()
+{
+	bStopping = true;
+	WakeEvent->Trigger();
+}
@@ -3,11 +3,37 @@
 #include "Simulation/AdaTickManager.h"
 
 #include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "UObject/GarbageCollection.h"
+#include "UObject/UObjectGlobals.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
 #include "Simulation/AdaTickManagerSettings.h"
 #include "Debug/AdaAssertionMacros.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(AdaTickManager)
 
+DEFINE_LOG_CATEGORY(LogAdaTickManager);
+
+CSV_DEFINE_CATEGORY(AdaTickManager, true);
+
+static FAutoConsoleCommandWithWorldAndArgs CVarDumpTickFunctionCosts(
+	TEXT("Ada.TickManager.DumpCosts"),
+	TEXT("Log the most expensive fixed step tick functions over the rolling cost window. Usage: Ada.TickManager.DumpCosts [Count=10]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const UAdaTickManager* const TickManager = IsValid(World) ? World->GetSubsystem<UAdaTickManager>() : nullptr;
+		if (!IsValid(TickManager))
+		{
+			UE_LOG(LogAdaTickManager, Warning, TEXT("Ada.TickManager.DumpCosts: No tick manager for the current world."));
+			return;
+		}
+
+		const int32 Count = Args.IsEmpty() ? 10 : FCString::Atoi(*Args[0]);
+		TickManager->DumpTickFunctionCosts(Count);
+	}));
+
 void UAdaTickManager::Initialize(FSubsystemCollectionBase& Collection)
 {
 	const UWorld* const World = GetWorld();
@@ -16,60 +42,327 @@ void UAdaTickManager::Initialize(FSubsystemCollectionBase& Collection)
 	const UAdaTickManagerSettings* const Settings = GetDefault<UAdaTickManagerSettings>();
 	A_ENSURE_RET(IsValid(Settings), void());
 
+	bUseEngineTickFunction = Settings->bUseEngineTickFunction;
+
 	if (World->WorldType == EWorldType::PIE || World->WorldType == EWorldType::Game)
 	{
+		// We always hook the pre actor tick, even when fixed steps are run elsewhere, as it's also our game thread handoff point.
 		PreWorldActorTickHandle = FWorldDelegates::OnWorldPreActorTick.AddUObject(this, &UAdaTickManager::OnWorldPreActorTick);
+		PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(this, &UAdaTickManager::OnPostGarbageCollect);
 	}
 	
 	FixedStepMS = 1000.0f / Settings->TargetTPS;
 	bUseAggregatedTicks = Settings->bUseAggregatedTicks;
+	MaxStepsPerFrame = bUseAggregatedTicks ? FMath::Max<uint8>(Settings->MaxStepsPerFrame, 1) : 1;
+	FrameBudgetMS = bUseAggregatedTicks ? FMath::Max(Settings->FrameBudgetMS, 0.0f) : 0.0f;
+	OverrunPolicy = Settings->OverrunPolicy;
+	MaxCarriedSteps = Settings->MaxCarriedSteps;
+	bAllowParallelTicks = Settings->bAllowParallelTicks && FApp::ShouldUseThreadingForPerformance();
+	CostWindowSize = FMath::Max(Settings->CostWindowSize, 1);
+	SubscriberBudgetMS = Settings->SubscriberBudgetMS;
+	BudgetWarningIntervalSeconds = Settings->BudgetWarningIntervalSeconds;
+	DeferredWorkBudgetMS = FMath::Max(Settings->DeferredWorkBudgetMS, 0.0f);
+	bUseSimulationThread = Settings->bUseSimulationThread;
+	bSimulationThreadDedicatedServerOnly = Settings->bSimulationThreadDedicatedServerOnly;
+
+	if (bUseEngineTickFunction)
+	{
+		FixedStepTickFunction.Target = this;
+		FixedStepTickFunction.bCanEverTick = true;
+		FixedStepTickFunction.bStartWithTickEnabled = true;
+		FixedStepTickFunction.bTickEvenWhenPaused = false;
+		FixedStepTickFunction.bRunOnAnyThread = Settings->bRunTickFunctionOnAnyThread;
+		FixedStepTickFunction.TickGroup = Settings->TickGroup;
+		FixedStepTickFunction.EndTickGroup = FMath::Max(Settings->EndTickGroup.GetValue(), Settings->TickGroup.GetValue());
+	}
+}
+
+void UAdaTickManager::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (InWorld.WorldType != EWorldType::PIE && InWorld.WorldType != EWorldType::Game)
+	{
+		return;
+	}
+
+	if (bUseSimulationThread && (!bSimulationThreadDedicatedServerOnly || InWorld.GetNetMode() == NM_DedicatedServer))
+	{
+		SimulationThread = MakeUnique<FAdaSimulationThread>(this, FixedStepMS / 1000.0, MaxCarriedSteps);
+		if (SimulationThread->Start())
+		{
+			UE_LOG(LogAdaTickManager, Log, TEXT("%hs: Running fixed steps on a dedicated simulation thread."), __FUNCTION__);
+			return;
+		}
+
+		UE_LOG(LogAdaTickManager, Warning, TEXT("%hs: Failed to start the simulation thread, falling back to running fixed steps on the game thread."), __FUNCTION__);
+		SimulationThread.Reset();
+	}
+
+	if (bUseEngineTickFunction)
+	{
+		A_ENSURE_RET(IsValid(InWorld.PersistentLevel), void());
+		FixedStepTickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+	}
 }
 
 void UAdaTickManager::Deinitialize()
 {
 	const UWorld* const World = GetWorld();
 	A_VALIDATE_OBJ(World, void());
+
+	// Stop the simulation thread before anything else, so that it can't run a step while we're tearing down.
+	SimulationThread.Reset();
 	
 	if (PreWorldActorTickHandle.IsValid())
 	{
 		FWorldDelegates::OnWorldPreActorTick.Remove(PreWorldActorTickHandle);
 	}
+
+	if (PostGarbageCollectHandle.IsValid())
+	{
+		FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+	}
+
+	if (FixedStepTickFunction.IsTickFunctionRegistered())
+	{
+		FixedStepTickFunction.UnRegisterTickFunction();
+	}
+
+	DeferredWorkQueue.Reset();
+	SimulationCommands.Empty();
+	GameThreadCallbacks.Empty();
+	TickBatches.Empty();
 }
 
-void UAdaTickManager::RegisterTickFunction(const UObject* const Object, const TFunction<void(const uint64&)>& TickFunction)
+FAdaTickFunctionHandle UAdaTickManager::RegisterTickFunction(const UObject* const Object, const TFunction<void(const uint64&)>& TickFunction, const FAdaTickFunctionParams& Params)
 {
-	FTickFunction* FoundTickFunction = TickFunctions.FindByPredicate([Object](const FTickFunction& TickFunction)
+	A_ENSURE_RET(TickFunction, FAdaTickFunctionHandle());
+
+	// Single-step tick functions are only ever called with a step count of 1, so the step count can be ignored.
+	return RegisterTickFunction_Internal(Object, [TickFunction](const uint64& Frame, const uint32)
 	{
-		return Object == TickFunction.ObjectToTick;
-	});
+		TickFunction(Frame);
+	}, false, Params);
+}
+
+FAdaTickFunctionHandle UAdaTickManager::RegisterMultiStepTickFunction(const UObject* const Object, const TFunction<void(const uint64&, const uint32)>& TickFunction, const FAdaTickFunctionParams& Params)
+{
+	A_ENSURE_RET(TickFunction, FAdaTickFunctionHandle());
 
-	if (FoundTickFunction)
+	return RegisterTickFunction_Internal(Object, CopyTemp(TickFunction), true, Params);
+}
+
+FAdaTickFunctionHandle UAdaTickManager::RegisterTickFunction_Internal(const UObject* const Object, TFunction<void(const uint64&, const uint32)>&& TickFunction, const bool bMultiStep, const FAdaTickFunctionParams& Params)
+{
+	A_ENSURE_MSG_RET(CanModifyRegistrations(), FAdaTickFunctionHandle(), TEXT("%hs: Tick functions must be registered from the game thread or during a fixed step."), __FUNCTION__);
+	FScopeLock Lock(&RegistrationCriticalSection);
+
+	A_VALIDATE_OBJ(Object, FAdaTickFunctionHandle());
+
+	if (ObjectToHandle.Contains(Object))
 	{
-		return;
+		return FAdaTickFunctionHandle();
 	}
 
-	FTickFunction NewTickFunction;
+	FAdaRegisteredTickFunction NewTickFunction;
 	NewTickFunction.ObjectToTick = Object;
-	NewTickFunction.TickFunction = TickFunction;
-	TickFunctions.Add(MoveTemp(NewTickFunction));
+	NewTickFunction.ObjectKey = FObjectKey(Object);
+	NewTickFunction.DebugName = FString::Printf(TEXT("%s:%s"), *GetNameSafe(Object->GetClass()), *Object->GetName());
+	NewTickFunction.ClassName = Object->GetClass()->GetFName();
+	NewTickFunction.TickFunction = MoveTemp(TickFunction);
+	NewTickFunction.bMultiStep = bMultiStep;
+	NewTickFunction.RateDivisor = FMath::Max<uint16>(Params.RateDivisor, 1);
+	NewTickFunction.bWorkerThreadSafe = Params.bWorkerThreadSafe;
+	NewTickFunction.bSimulationThreadSafe = Params.bSimulationThreadSafe;
+	NewTickFunction.Prerequisites = Params.Prerequisites;
+
+	FAdaTickFunctionHandle NewHandle;
+	if (!ShouldDeferRegistrationChanges())
+	{
+		const int32 Index = FreeSlots.IsEmpty() ? TickFunctions.AddDefaulted() : FreeSlots.Pop(EAllowShrinking::No);
+		const uint32 Generation = TickFunctions[Index].Generation + 1;
+		ActivateSlot(Index, Generation, MoveTemp(NewTickFunction));
+
+		NewHandle = FAdaTickFunctionHandle(Index, Generation);
+	}
+	else
+	{
+		// We can't touch the slot array while a step is running, as worker tasks may be holding references into it.
+		// Reserve a slot now so that we can hand out a handle, and fill it in at the next step boundary.
+		FPendingTickFunction& PendingTickFunction = PendingAdditions.AddDefaulted_GetRef();
+		if (!FreeSlots.IsEmpty())
+		{
+			PendingTickFunction.Index = FreeSlots.Pop(EAllowShrinking::No);
+			PendingTickFunction.Generation = TickFunctions[PendingTickFunction.Index].Generation + 1;
+		}
+		else
+		{
+			PendingTickFunction.Index = TickFunctions.Num() + ReservedSlotCount++;
+			PendingTickFunction.Generation = 1;
+		}
+
+		PendingTickFunction.TickFunction = MoveTemp(NewTickFunction);
+
+		NewHandle = FAdaTickFunctionHandle(PendingTickFunction.Index, PendingTickFunction.Generation);
+	}
+
+	ObjectToHandle.Add(Object, NewHandle);
+	return NewHandle;
 }
 
 void UAdaTickManager::UnregisterTickFunction(const UObject* const Object)
 {
-	for (int32 i = TickFunctions.Num() - 1; i >= 0; i--)
+	A_ENSURE_MSG_RET(CanModifyRegistrations(), void(), TEXT("%hs: Tick functions must be unregistered from the game thread or during a fixed step."), __FUNCTION__);
+	FScopeLock Lock(&RegistrationCriticalSection);
+
+	FAdaTickFunctionHandle Handle;
+	if (ObjectToHandle.RemoveAndCopyValue(Object, Handle))
+	{
+		UnregisterTickFunction(Handle);
+	}
+}
+
+void UAdaTickManager::UnregisterTickFunction(FAdaTickFunctionHandle& Handle)
+{
+	A_ENSURE_MSG_RET(CanModifyRegistrations(), void(), TEXT("%hs: Tick functions must be unregistered from the game thread or during a fixed step."), __FUNCTION__);
+	FScopeLock Lock(&RegistrationCriticalSection);
+
+	if (!Handle.IsValid())
+	{
+		return;
+	}
+
+	ON_SCOPE_EXIT
+	{
+		Handle.Invalidate();
+	};
+
+	if (TickFunctions.IsValidIndex(Handle.Index))
 	{
-		const UObject* const FoundObject = TickFunctions[i].ObjectToTick.Get();
-		if (!IsValid(FoundObject))
+		const FAdaRegisteredTickFunction& TickFunction = TickFunctions[Handle.Index];
+		if (TickFunction.bActive && TickFunction.Generation == Handle.Generation)
 		{
-			TickFunctions.RemoveAt(i);
-			continue;
+			ObjectToHandle.Remove(TickFunction.ObjectKey);
+			RemoveSlot(Handle.Index);
+			return;
 		}
-		else if (FoundObject == Object)
+	}
+
+	// The tick function may still be waiting to be added.
+	for (FPendingTickFunction& PendingTickFunction : PendingAdditions)
+	{
+		if (!PendingTickFunction.bCancelled && PendingTickFunction.Index == Handle.Index && PendingTickFunction.Generation == Handle.Generation)
 		{
-			TickFunctions.RemoveAt(i);
-			break;
+			ObjectToHandle.Remove(PendingTickFunction.TickFunction.ObjectKey);
+			PendingTickFunction.bCancelled = true;
+			return;
+		}
+	}
+}
+
+void UAdaTickManager::UnregisterBatchedTickFunction(const UObject* const Object, const UClass* const BatchClass)
+{
+	A_ENSURE_MSG_RET(CanModifyRegistrations(), void(), TEXT("%hs: Tick functions must be unregistered from the game thread or during a fixed step."), __FUNCTION__);
+	A_ENSURE_MSG_RET(!SimulationThread.IsValid() || IsInGameThread(), void(), TEXT("%hs: Batched tick functions must be unregistered from the game thread when running a simulation thread."), __FUNCTION__);
+
+	TOptional<FScopeLock> Lock;
+	if (!SimulationThread.IsValid())
+	{
+		Lock.Emplace(&RegistrationCriticalSection);
+	}
+
+	if (TUniquePtr<FAdaTickBatchBase>* const Batch = TickBatches.Find(BatchClass))
+	{
+		(*Batch)->Remove(Object, ShouldDeferBatchChanges());
+	}
+}
+
+bool UAdaTickManager::CanRegisterBatchedTickFunction(const UObject* const Object) const
+{
+	A_ENSURE_MSG_RET(CanModifyRegistrations(), false, TEXT("%hs: Tick functions must be registered from the game thread or during a fixed step."), __FUNCTION__);
+	A_ENSURE_MSG_RET(!SimulationThread.IsValid() || IsInGameThread(), false, TEXT("%hs: Batched tick functions must be registered from the game thread when running a simulation thread."), __FUNCTION__);
+	A_VALIDATE_OBJ(Object, false);
+
+	return true;
+}
+
+FAdaDeferredWorkHandle UAdaTickManager::SubmitDeferredWork(FAdaDeferredWork&& Work, const EAdaDeferredWorkPriority Priority, const UObject* const Owner)
+{
+	A_ENSURE_MSG_RET(CanModifyRegistrations(), FAdaDeferredWorkHandle(), TEXT("%hs: Deferred work must be submitted from the game thread or during a fixed step."), __FUNCTION__);
+
+	if (SimulationThread.IsValid())
+	{
+		if (IsInGameThread())
+		{
+			return DeferredWorkQueue.Submit(MoveTemp(Work), Priority, Owner, GetCurrentFrame());
+		}
+
+		// The queue belongs to the game thread, so hand the work over to it, under a handle we can give out now.
+		const FAdaDeferredWorkHandle Handle = DeferredWorkQueue.ReserveHandle();
+		GameThreadCallbacks.Enqueue([this, Work = MoveTemp(Work), Priority, WeakOwner = TWeakObjectPtr<const UObject>(Owner), bHasOwner = Owner != nullptr, Frame = GetCurrentFrame(), Handle]() mutable
+		{
+			// Work whose owner has already gone away has nothing left to work on.
+			if (!bHasOwner || WeakOwner.IsValid())
+			{
+				DeferredWorkQueue.Submit(MoveTemp(Work), Priority, WeakOwner.Get(), Frame, Handle);
+			}
+		});
+
+		return Handle;
+	}
+
+	FScopeLock Lock(&RegistrationCriticalSection);
+
+	return DeferredWorkQueue.Submit(MoveTemp(Work), Priority, Owner, GetCurrentFrame());
+}
+
+void UAdaTickManager::CancelDeferredWork(FAdaDeferredWorkHandle& Handle)
+{
+	A_ENSURE_MSG_RET(CanModifyRegistrations(), void(), TEXT("%hs: Deferred work must be cancelled from the game thread or during a fixed step."), __FUNCTION__);
+
+	if (SimulationThread.IsValid())
+	{
+		// Go through the game thread callbacks even from the game thread, so that the work is cancelled after any handover of it
+		// from the simulation thread.
+		GameThreadCallbacks.Enqueue([this, CancelledHandle = Handle]() mutable
+		{
+			DeferredWorkQueue.Cancel(CancelledHandle);
+		});
+
+		Handle.Invalidate();
+		return;
+	}
+
+	FScopeLock Lock(&RegistrationCriticalSection);
+
+	DeferredWorkQueue.Cancel(Handle);
+}
+
+bool UAdaTickManager::IsTickFunctionRegistered(const FAdaTickFunctionHandle& Handle) const
+{
+	A_ENSURE_MSG_RET(CanModifyRegistrations(), false, TEXT("%hs: Tick functions must be queried from the game thread or during a fixed step."), __FUNCTION__);
+	FScopeLock Lock(&RegistrationCriticalSection);
+
+	if (!Handle.IsValid())
+	{
+		return false;
+	}
+
+	if (TickFunctions.IsValidIndex(Handle.Index))
+	{
+		const FAdaRegisteredTickFunction& TickFunction = TickFunctions[Handle.Index];
+		if (TickFunction.bActive && !TickFunction.bPendingRemoval && TickFunction.Generation == Handle.Generation)
+		{
+			// Removals from the game thread don't mark the slot when there's a simulation thread.
+			return !SimulationThread.IsValid() || !PendingRemovals.Contains(Handle.Index);
 		}
 	}
+
+	return PendingAdditions.ContainsByPredicate([&Handle](const FPendingTickFunction& PendingTickFunction)
+	{
+		return !PendingTickFunction.bCancelled && PendingTickFunction.Index == Handle.Index && PendingTickFunction.Generation == Handle.Generation;
+	});
 }
 
 void UAdaTickManager::OnWorldPreActorTick(UWorld* InWorld, ELevelTick InLevelTick, float InDeltaSeconds)
@@ -79,40 +372,807 @@ void UAdaTickManager::OnWorldPreActorTick(UWorld* InWorld, ELevelTick InLevelTic
 	{
 		return;
 	}
-	
-	if (InWorld->IsPaused())
+
+	if (SimulationThread.IsValid())
 	{
-		return;
+		SimulationThread->SetPaused(InWorld->IsPaused());
 	}
-	
-	const float EngineFrameDeltaTimeMS = InDeltaSeconds * 1000.0f;
+	else if (!bUseEngineTickFunction && !InWorld->IsPaused())
+	{
+		AdvanceFixedSteps(InDeltaSeconds);
+	}
+
+	ProcessGameThreadCallbacks();
+
+	// Deferred work is largely game thread cleanup, so when steps are run elsewhere, it's run here instead, after any steps' callbacks.
+	if (SimulationThread.IsValid() && !InWorld->IsPaused())
+	{
+		DrainDeferredWork();
+	}
+}
+
+float UAdaTickManager::GetTimeUntilNextStepMS() const
+{
+	if (SimulationThread.IsValid())
+	{
+		return SimulationThread->GetTimeUntilNextStepMS();
+	}
+
+	return FMath::Max(FixedStepMS - PublishedUnspentTimeMS.load(std::memory_order_relaxed), 0.0f);
+}
+
+void UAdaTickManager::AdvanceFixedSteps(const float DeltaSeconds)
+{
+	FScopeLock Lock(&RegistrationCriticalSection);
+
+	FixedStepThreadId = FPlatformTLS::GetCurrentThreadId();
+	ON_SCOPE_EXIT
+	{
+		FixedStepThreadId = 0;
+	};
+
+	const float EngineFrameDeltaTimeMS = DeltaSeconds * 1000.0f;
 
 	UnspentTimeMS += EngineFrameDeltaTimeMS;
 
+	// When stretching, only repay up to a single step's worth of debt per frame so the catch-up is spread out.
+	if (CatchUpDebtMS > 0.0f)
+	{
+		const float RepaidTimeMS = FMath::Min(CatchUpDebtMS, FixedStepMS);
+		CatchUpDebtMS -= RepaidTimeMS;
+		UnspentTimeMS += RepaidTimeMS;
+	}
+
+	const double FrameStartSeconds = FPlatformTime::Seconds();
 	uint8 TickCount = 0;
 
 	// In practice, we end up running slightly below our frame target, but this is probably fine.
-	while (UnspentTimeMS + KINDA_SMALL_NUMBER >= FixedStepMS)
+	while (UnspentTimeMS + KINDA_SMALL_NUMBER >= FixedStepMS && TickCount < MaxStepsPerFrame)
 	{
+		// Always run at least one step so that the simulation keeps moving, even if a single step exceeds the budget.
+		if (TickCount > 0 && FrameBudgetMS > 0.0f && (FPlatformTime::Seconds() - FrameStartSeconds) * 1000.0 >= FrameBudgetMS)
+		{
+			break;
+		}
+
 		UnspentTimeMS -= FixedStepMS;
 		
 		TickCount++;
-		CurrentFrame++;
 
-		for (const FTickFunction& TickFunction : TickFunctions)
+		RunFixedStep();
+	}
+
+	HandleLeftoverSteps();
+
+	PublishedUnspentTimeMS.store(UnspentTimeMS, std::memory_order_relaxed);
+}
+
+void UAdaTickManager::RunSimulationThreadStep()
+{
+	// Hold off garbage collection while the step runs, as tick functions will be touching UObjects.
+	FGCScopeGuard GCGuard;
+
+	// The registration lock is only taken at the step boundaries, so that the game thread never has to wait for a whole step to
+	// register or unregister something.
+	FScopeLock StepLock(&StepCriticalSection);
+
+	FixedStepThreadId = FPlatformTLS::GetCurrentThreadId();
+	ON_SCOPE_EXIT
+	{
+		FixedStepThreadId = 0;
+	};
+
+	// Pick up anything the game thread changed since the last step.
+	FlushPendingChanges();
+
+	RunFixedStep();
+}
+
+void UAdaTickManager::EnqueueSimulationCommand(TUniqueFunction<void()>&& Command)
+{
+	A_ENSURE_RET(Command, void());
+	SimulationCommands.Enqueue(MoveTemp(Command));
+}
+
+void UAdaTickManager::EnqueueGameThreadCallback(TUniqueFunction<void()>&& Callback)
+{
+	A_ENSURE_RET(Callback, void());
+	GameThreadCallbacks.Enqueue(MoveTemp(Callback));
+}
+
+void UAdaTickManager::ProcessSimulationCommands()
+{
+	TUniqueFunction<void()> Command;
+	while (SimulationCommands.Dequeue(Command))
+	{
+		Command();
+	}
+}
+
+void UAdaTickManager::ProcessGameThreadCallbacks()
+{
+	TUniqueFunction<void()> Callback;
+	while (GameThreadCallbacks.Dequeue(Callback))
+	{
+		Callback();
+	}
+}
+
+bool UAdaTickManager::CanModifyRegistrations() const
+{
+	return IsInGameThread() || FixedStepThreadId == FPlatformTLS::GetCurrentThreadId();
+}
+
+void UAdaTickManager::AddFixedStepPrerequisite(UObject* TargetObject, FTickFunction& TargetTickFunction)
+{
+	if (bUseEngineTickFunction)
+	{
+		FixedStepTickFunction.AddPrerequisite(TargetObject, TargetTickFunction);
+	}
+}
+
+void UAdaTickManager::RemoveFixedStepPrerequisite(UObject* TargetObject, FTickFunction& TargetTickFunction)
+{
+	if (bUseEngineTickFunction)
+	{
+		FixedStepTickFunction.RemovePrerequisite(TargetObject, TargetTickFunction);
+	}
+}
+
+FTickFunction* UAdaTickManager::GetFixedStepTickFunction()
+{
+	return bUseEngineTickFunction ? &FixedStepTickFunction : nullptr;
+}
+
+void UAdaTickManager::RunFixedStep(const uint32 StepCount)
+{
+	A_ENSURE_RET(StepCount > 0, void());
+
+	ProcessSimulationCommands();
+
+	CurrentFrame.fetch_add(StepCount, std::memory_order_relaxed);
+
+	if (bExecutionOrderDirty)
+	{
+		// Prerequisites are resolved through ObjectToHandle, which the game thread may be changing when there's a simulation thread.
+		FScopeLock Lock(&RegistrationCriticalSection);
+		RebuildExecutionOrder();
+	}
+
+	bIsTicking = true;
+
+	StepTasks.Reset();
+	StepTasks.SetNum(TickFunctions.Num());
+
+	auto RunTickFunction = [this, StepCount](const int32 Index, TArray<UE::Tasks::FTask, TInlineAllocator<8>>& Prerequisites)
+	{
+		FAdaRegisteredTickFunction& TickFunction = TickFunctions[Index];
+		if (!TickFunction.bActive || TickFunction.bPendingRemoval)
+		{
+			return;
+		}
+
+		FDueSteps DueSteps;
+		if (!GetDueSteps(TickFunction, StepCount, DueSteps))
+		{
+			return;
+		}
+
+		const UObject* const ObjectToTick = TickFunction.ObjectToTick.Get();
+		if (!A_ENSURE_MSG(IsValid(ObjectToTick), TEXT("%hs: Invalid object!"), __FUNCTION__))
+		{
+			// The owner was destroyed without unregistering, so clean up after it.
+			FScopeLock Lock(&RegistrationCriticalSection);
+			ObjectToHandle.Remove(TickFunction.ObjectKey);
+			RemoveSlot(Index);
+			return;
+		}
+
+		TickFunction.LastRunFrame = DueSteps.LastFrame;
+
+		if (SimulationThread.IsValid() && !TickFunction.bSimulationThreadSafe)
 		{
-			const UObject* const ObjectToTick = TickFunction.ObjectToTick.Get();
-			if (!A_ENSURE_MSG(IsValid(ObjectToTick), TEXT("%hs: Invalid object!"), __FUNCTION__))
+			// Hand tick functions that can't run on the simulation thread back to the game thread, to run at the next handoff.
+			GameThreadCallbacks.Enqueue([Function = TickFunction.TickFunction, bMultiStep = TickFunction.bMultiStep, RateDivisor = TickFunction.RateDivisor, DueSteps]()
 			{
-				continue;
+				DispatchTickFunction(Function, bMultiStep, RateDivisor, DueSteps);
+			});
+
+			return;
+		}
+
+		// Prerequisites that aren't due this step won't have a valid task, so we simply don't wait on them.
+		Prerequisites.Reset();
+		if (PrerequisiteIndices.IsValidIndex(Index))
+		{
+			for (const int32 PrerequisiteIndex : PrerequisiteIndices[Index])
+			{
+				if (StepTasks[PrerequisiteIndex].IsValid())
+				{
+					Prerequisites.Add(StepTasks[PrerequisiteIndex]);
+				}
+			}
+		}
+
+		if (bAllowParallelTicks && TickFunction.bWorkerThreadSafe)
+		{
+			StepTasks[Index] = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, &TickFunction, DueSteps]()
+			{
+				InvokeTickFunction(TickFunction, DueSteps);
+			}, Prerequisites);
+		}
+		else
+		{
+			// Game thread tick functions block on any worker prerequisites, but other independent workers carry on in the background.
+			if (!Prerequisites.IsEmpty())
+			{
+				UE::Tasks::Wait(Prerequisites);
 			}
 
-			TickFunction.TickFunction(CurrentFrame);
+			InvokeTickFunction(TickFunction, DueSteps);
 		}
+	};
 
-		if (!bUseAggregatedTicks)
+	TArray<UE::Tasks::FTask, TInlineAllocator<8>> Prerequisites;
+	if (PrerequisiteUserCount > 0)
+	{
+		for (const int32 Index : ExecutionOrder)
 		{
-			break;
+			RunTickFunction(Index, Prerequisites);
 		}
 	}
-}
\ No newline at end of file
+	else
+	{
+		for (int32 Index = 0; Index < TickFunctions.Num(); Index++)
+		{
+			RunTickFunction(Index, Prerequisites);
+		}
+	}
+
+	// Batches run on this thread while any worker tick functions finish up in the background.
+	RunTickBatches(StepCount);
+
+	// Join all worker tick functions before the step ends.
+	for (const UE::Tasks::FTask& StepTask : StepTasks)
+	{
+		if (StepTask.IsValid())
+		{
+			StepTask.Wait();
+		}
+	}
+
+	StepTasks.Reset();
+
+	bIsTicking = false;
+
+	FlushPendingChanges();
+
+	// Deferred work runs after all tick functions have finished, so it's free to register and unregister them.
+	if (!SimulationThread.IsValid())
+	{
+		DrainDeferredWork();
+	}
+}
+
+void UAdaTickManager::DrainDeferredWork()
+{
+	DeferredWorkQueue.Drain(GetCurrentFrame(), DeferredWorkBudgetMS);
+
+	CSV_CUSTOM_STAT(AdaTickManager, DeferredWorkQueueDepth, DeferredWorkQueue.Num(), ECsvCustomStatOp::Set);
+}
+
+void UAdaTickManager::RunTickBatches(const uint32 StepCount)
+{
+	const uint64 LastFrame = GetCurrentFrame();
+	const uint64 FirstFrame = LastFrame - StepCount + 1;
+
+	if (SimulationThread.IsValid())
+	{
+		// Batches belong to the game thread, so hand the whole step's worth back to it. Batches are only ever added, changed, and run
+		// from the game thread in this mode, so it doesn't need to wait on us for anything.
+		GameThreadCallbacks.Enqueue([this, FirstFrame, LastFrame]()
+		{
+			ExecuteTickBatches(FirstFrame, LastFrame);
+		});
+
+		return;
+	}
+
+	ExecuteTickBatches(FirstFrame, LastFrame);
+}
+
+void UAdaTickManager::ExecuteTickBatches(const uint64 FirstFrame, const uint64 LastFrame)
+{
+	for (TPair<const UClass*, TUniquePtr<FAdaTickBatchBase>>& Batch : TickBatches)
+	{
+#if CSV_PROFILER
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+#endif
+		{
+			TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*Batch.Value->DebugName);
+			for (uint64 Frame = FirstFrame; Frame <= LastFrame; Frame++)
+			{
+				Batch.Value->Execute(Frame);
+			}
+		}
+
+		// Without a simulation thread, changes made while executing are flushed with everything else at the end of the step.
+		if (SimulationThread.IsValid())
+		{
+			Batch.Value->FlushPendingChanges();
+		}
+
+#if CSV_PROFILER
+		const float CostMS = static_cast<float>(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles));
+		FCsvProfiler::RecordCustomStat(Batch.Value->ClassName, CSV_CATEGORY_INDEX(AdaTickManager), CostMS, ECsvCustomStatOp::Accumulate);
+#endif
+	}
+}
+
+void UAdaTickManager::OnPostGarbageCollect()
+{
+	for (TPair<const UClass*, TUniquePtr<FAdaTickBatchBase>>& Batch : TickBatches)
+	{
+		Batch.Value->ValidateInstances();
+	}
+}
+
+bool UAdaTickManager::GetDueSteps(const FAdaRegisteredTickFunction& TickFunction, const uint32 StepCount, FDueSteps& OutDueSteps) const
+{
+	const uint64 LastFrame = GetCurrentFrame();
+	if (TickFunction.RateDivisor <= 1)
+	{
+		OutDueSteps.LastFrame = LastFrame;
+		OutDueSteps.Count = StepCount;
+	}
+	else
+	{
+		// Find the first frame of the step that falls on this tick function's phase, then count every RateDivisor frames from there.
+		const uint64 FirstFrame = LastFrame - StepCount + 1;
+		const uint64 FirstDueFrame = FirstFrame + (TickFunction.Phase + TickFunction.RateDivisor - FirstFrame % TickFunction.RateDivisor) % TickFunction.RateDivisor;
+		if (FirstDueFrame > LastFrame)
+		{
+			return false;
+		}
+
+		OutDueSteps.Count = static_cast<uint32>((LastFrame - FirstDueFrame) / TickFunction.RateDivisor) + 1;
+		OutDueSteps.LastFrame = FirstDueFrame + static_cast<uint64>(OutDueSteps.Count - 1) * TickFunction.RateDivisor;
+	}
+
+	OutDueSteps.ElapsedSteps = static_cast<uint32>(FMath::Max<uint64>(OutDueSteps.LastFrame - TickFunction.LastRunFrame, 1));
+	return true;
+}
+
+void UAdaTickManager::DispatchTickFunction(const TFunction<void(const uint64&, const uint32)>& Function, const bool bMultiStep, const uint16 RateDivisor, const FDueSteps& DueSteps)
+{
+	if (bMultiStep)
+	{
+		Function(DueSteps.LastFrame, DueSteps.ElapsedSteps);
+		return;
+	}
+
+	// Single-step tick functions see every frame they were due on, in order.
+	for (uint32 Remaining = DueSteps.Count; Remaining > 0; Remaining--)
+	{
+		Function(DueSteps.LastFrame - static_cast<uint64>(Remaining - 1) * RateDivisor, 1);
+	}
+}
+
+void UAdaTickManager::InvokeTickFunction(FAdaRegisteredTickFunction& TickFunction, const FDueSteps& DueSteps) const
+{
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*TickFunction.DebugName);
+		DispatchTickFunction(TickFunction.TickFunction, TickFunction.bMultiStep, TickFunction.RateDivisor, DueSteps);
+	}
+	const float CostMS = static_cast<float>(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles));
+
+	if (TickFunction.CostSamplesMS.Num() != CostWindowSize)
+	{
+		TickFunction.CostSamplesMS.Reset(CostWindowSize);
+		TickFunction.NextCostSample = 0;
+	}
+
+	if (TickFunction.CostSamplesMS.Num() < CostWindowSize)
+	{
+		TickFunction.CostSamplesMS.Add(CostMS);
+	}
+	else
+	{
+		TickFunction.CostSamplesMS[TickFunction.NextCostSample] = CostMS;
+		TickFunction.NextCostSample = (TickFunction.NextCostSample + 1) % CostWindowSize;
+	}
+
+#if CSV_PROFILER
+	FCsvProfiler::RecordCustomStat(TickFunction.ClassName, CSV_CATEGORY_INDEX(AdaTickManager), CostMS, ECsvCustomStatOp::Accumulate);
+#endif
+
+	if (SubscriberBudgetMS > 0.0f && CostMS > SubscriberBudgetMS)
+	{
+		const double NowSeconds = FPlatformTime::Seconds();
+		if (NowSeconds - TickFunction.LastBudgetWarningSeconds >= BudgetWarningIntervalSeconds)
+		{
+			TickFunction.LastBudgetWarningSeconds = NowSeconds;
+			UE_LOG(LogAdaTickManager, Warning, TEXT("%hs: Tick function %s took %.3fms on frame %llu, exceeding its budget of %.3fms."), __FUNCTION__, *TickFunction.DebugName, CostMS, DueSteps.LastFrame, SubscriberBudgetMS);
+		}
+	}
+}
+
+void UAdaTickManager::RemoveSlot(const int32 Index)
+{
+	FAdaRegisteredTickFunction& TickFunction = TickFunctions[Index];
+	if (!TickFunction.bActive || TickFunction.bPendingRemoval)
+	{
+		return;
+	}
+
+	if (SimulationThread.IsValid() && IsInGameThread())
+	{
+		// The simulation thread may be reading the slot, so leave it be. The tick function keeps running until the next step boundary.
+		PendingRemovals.AddUnique(Index);
+	}
+	else if (ShouldDeferRegistrationChanges())
+	{
+		TickFunction.bPendingRemoval = true;
+		PendingRemovals.Add(Index);
+	}
+	else
+	{
+		ReleaseSlot(Index);
+	}
+}
+
+void UAdaTickManager::FlushPendingChanges()
+{
+	FScopeLock Lock(&RegistrationCriticalSection);
+
+	for (const int32 Index : PendingRemovals)
+	{
+		ReleaseSlot(Index);
+	}
+
+	PendingRemovals.Reset();
+
+	// Batches flush themselves on the game thread when there's a simulation thread.
+	if (!SimulationThread.IsValid())
+	{
+		for (TPair<const UClass*, TUniquePtr<FAdaTickBatchBase>>& Batch : TickBatches)
+		{
+			Batch.Value->FlushPendingChanges();
+		}
+	}
+
+	if (ReservedSlotCount > 0)
+	{
+		TickFunctions.AddDefaulted(ReservedSlotCount);
+		ReservedSlotCount = 0;
+	}
+
+	for (FPendingTickFunction& PendingTickFunction : PendingAdditions)
+	{
+		if (PendingTickFunction.bCancelled)
+		{
+			// Burn the generation so that the handle we gave out stays stale, then return the slot.
+			TickFunctions[PendingTickFunction.Index].Generation = PendingTickFunction.Generation;
+			FreeSlots.Add(PendingTickFunction.Index);
+			continue;
+		}
+
+		ActivateSlot(PendingTickFunction.Index, PendingTickFunction.Generation, MoveTemp(PendingTickFunction.TickFunction));
+	}
+
+	PendingAdditions.Reset();
+}
+
+void UAdaTickManager::ActivateSlot(const int32 Index, const uint32 Generation, FAdaRegisteredTickFunction&& TickFunction)
+{
+	FAdaRegisteredTickFunction& Slot = TickFunctions[Index];
+	A_ENSURE(!Slot.bActive);
+
+	Slot = MoveTemp(TickFunction);
+	Slot.Generation = Generation;
+	Slot.Phase = AssignPhase(Slot.RateDivisor);
+	Slot.LastRunFrame = GetCurrentFrame();
+	Slot.bActive = true;
+	Slot.bPendingRemoval = false;
+
+	if (!Slot.Prerequisites.IsEmpty())
+	{
+		PrerequisiteUserCount++;
+	}
+
+	bExecutionOrderDirty = true;
+}
+
+void UAdaTickManager::ReleaseSlot(const int32 Index)
+{
+	FAdaRegisteredTickFunction& Slot = TickFunctions[Index];
+	if (!Slot.bActive)
+	{
+		return;
+	}
+
+	ReleasePhase(Slot.RateDivisor, Slot.Phase);
+
+	if (!Slot.Prerequisites.IsEmpty())
+	{
+		PrerequisiteUserCount--;
+	}
+
+	// Keep the generation so the next occupant can increment it.
+	const uint32 Generation = Slot.Generation;
+	Slot = FAdaRegisteredTickFunction();
+	Slot.Generation = Generation;
+
+	FreeSlots.Add(Index);
+
+	bExecutionOrderDirty = true;
+}
+
+void UAdaTickManager::RebuildExecutionOrder()
+{
+	bExecutionOrderDirty = false;
+
+	const int32 SlotCount = TickFunctions.Num();
+
+	PrerequisiteIndices.Reset();
+	ExecutionOrder.Reset();
+
+	// Without any prerequisites we just walk the slot array in order.
+	if (PrerequisiteUserCount <= 0)
+	{
+		return;
+	}
+
+	PrerequisiteIndices.SetNum(SlotCount);
+
+	TArray<TArray<int32>> Dependants;
+	Dependants.SetNum(SlotCount);
+
+	TArray<int32> UnresolvedCounts;
+	UnresolvedCounts.SetNumZeroed(SlotCount);
+
+	int32 ActiveCount = 0;
+	for (int32 Index = 0; Index < SlotCount; Index++)
+	{
+		const FAdaRegisteredTickFunction& TickFunction = TickFunctions[Index];
+		if (!TickFunction.bActive)
+		{
+			continue;
+		}
+
+		ActiveCount++;
+
+		for (const TWeakObjectPtr<const UObject>& Prerequisite : TickFunction.Prerequisites)
+		{
+			// Prerequisites that aren't registered with us, or are still pending, are ignored.
+			const FAdaTickFunctionHandle* const PrerequisiteHandle = ObjectToHandle.Find(Prerequisite.Get());
+			if (!PrerequisiteHandle || PrerequisiteHandle->Index == Index || !TickFunctions.IsValidIndex(PrerequisiteHandle->Index))
+			{
+				continue;
+			}
+
+			const FAdaRegisteredTickFunction& PrerequisiteTickFunction = TickFunctions[PrerequisiteHandle->Index];
+			if (!PrerequisiteTickFunction.bActive || PrerequisiteTickFunction.Generation != PrerequisiteHandle->Generation)
+			{
+				continue;
+			}
+
+			PrerequisiteIndices[Index].AddUnique(PrerequisiteHandle->Index);
+			Dependants[PrerequisiteHandle->Index].Add(Index);
+			UnresolvedCounts[Index]++;
+		}
+	}
+
+	// Kahn's algorithm, seeded in slot order so that the order of independent tick functions remains stable.
+	ExecutionOrder.Reserve(ActiveCount);
+	for (int32 Index = 0; Index < SlotCount; Index++)
+	{
+		if (TickFunctions[Index].bActive && UnresolvedCounts[Index] == 0)
+		{
+			ExecutionOrder.Add(Index);
+		}
+	}
+
+	for (int32 OrderIndex = 0; OrderIndex < ExecutionOrder.Num(); OrderIndex++)
+	{
+		for (const int32 Dependant : Dependants[ExecutionOrder[OrderIndex]])
+		{
+			if (--UnresolvedCounts[Dependant] == 0)
+			{
+				ExecutionOrder.Add(Dependant);
+			}
+		}
+	}
+
+	// Anything left over is part of a cycle. Run those in slot order without their prerequisites rather than not at all.
+	if (ExecutionOrder.Num() != ActiveCount)
+	{
+		for (int32 Index = 0; Index < SlotCount; Index++)
+		{
+			if (UnresolvedCounts[Index] > 0)
+			{
+				UE_LOG(LogAdaTickManager, Error, TEXT("%hs: Circular tick prerequisites detected for %s; ignoring its prerequisites."), __FUNCTION__, *GetNameSafe(TickFunctions[Index].ObjectToTick.Get()));
+				PrerequisiteIndices[Index].Reset();
+				ExecutionOrder.Add(Index);
+			}
+		}
+	}
+}
+
+void UAdaTickManager::GetTickFunctionCosts(TArray<FAdaTickFunctionCostReport>& OutReports) const
+{
+	OutReports.Reset();
+
+	// Costs are recorded while steps run, possibly on other threads, so this has to wait for any step in progress.
+	// It's only used for reporting, so that's an acceptable hitch.
+	FScopeLock StepLock(&StepCriticalSection);
+	FScopeLock Lock(&RegistrationCriticalSection);
+
+	TArray<float> SortedSamples;
+	for (const FAdaRegisteredTickFunction& TickFunction : TickFunctions)
+	{
+		if (!TickFunction.bActive || TickFunction.CostSamplesMS.IsEmpty())
+		{
+			continue;
+		}
+
+		SortedSamples = TickFunction.CostSamplesMS;
+		SortedSamples.Sort();
+
+		float TotalMS = 0.0f;
+		for (const float SampleMS : SortedSamples)
+		{
+			TotalMS += SampleMS;
+		}
+
+		const int32 SampleCount = SortedSamples.Num();
+		const int32 P95Index = FMath::Clamp(FMath::CeilToInt32(SampleCount * 0.95f) - 1, 0, SampleCount - 1);
+
+		FAdaTickFunctionCostReport& Report = OutReports.AddDefaulted_GetRef();
+		Report.ClassName = TickFunction.ClassName.ToString();
+		Report.ObjectName = GetNameSafe(TickFunction.ObjectToTick.Get());
+		Report.MinMS = SortedSamples[0];
+		Report.MeanMS = TotalMS / SampleCount;
+		Report.P95MS = SortedSamples[P95Index];
+		Report.MaxMS = SortedSamples.Last();
+		Report.SampleCount = SampleCount;
+	}
+
+	OutReports.Sort([](const FAdaTickFunctionCostReport& A, const FAdaTickFunctionCostReport& B)
+	{
+		return A.P95MS > B.P95MS;
+	});
+}
+
+void UAdaTickManager::DumpTickFunctionCosts(const int32 Count) const
+{
+	TArray<FAdaTickFunctionCostReport> Reports;
+	GetTickFunctionCosts(Reports);
+
+	UE_LOG(LogAdaTickManager, Display, TEXT("Tick function costs over the last %i fixed steps (%i tick functions with samples):"), CostWindowSize, Reports.Num());
+	UE_LOG(LogAdaTickManager, Display, TEXT("%-48s %-32s %9s %9s %9s %9s"), TEXT("Class"), TEXT("Object"), TEXT("Min"), TEXT("Mean"), TEXT("P95"), TEXT("Max"));
+
+	const int32 ReportCount = FMath::Min(FMath::Max(Count, 1), Reports.Num());
+	for (int32 Index = 0; Index < ReportCount; Index++)
+	{
+		const FAdaTickFunctionCostReport& Report = Reports[Index];
+		UE_LOG(LogAdaTickManager, Display, TEXT("%-48s %-32s %7.3fms %7.3fms %7.3fms %7.3fms"), *Report.ClassName, *Report.ObjectName, Report.MinMS, Report.MeanMS, Report.P95MS, Report.MaxMS);
+	}
+}
+
+uint16 UAdaTickManager::AssignPhase(const uint16 RateDivisor)
+{
+	if (RateDivisor <= 1)
+	{
+		return 0;
+	}
+
+	TArray<int32>& Loads = PhaseLoads.FindOrAdd(RateDivisor);
+	if (Loads.Num() != RateDivisor)
+	{
+		Loads.SetNumZeroed(RateDivisor);
+	}
+
+	// Linear in the rate divisor, which we expect to be small.
+	uint16 LeastLoadedPhase = 0;
+	for (uint16 Phase = 1; Phase < RateDivisor; Phase++)
+	{
+		if (Loads[Phase] < Loads[LeastLoadedPhase])
+		{
+			LeastLoadedPhase = Phase;
+		}
+	}
+
+	Loads[LeastLoadedPhase]++;
+	return LeastLoadedPhase;
+}
+
+void UAdaTickManager::ReleasePhase(const uint16 RateDivisor, const uint16 Phase)
+{
+	if (RateDivisor <= 1)
+	{
+		return;
+	}
+
+	TArray<int32>* const Loads = PhaseLoads.Find(RateDivisor);
+	A_ENSURE_RET(Loads && Loads->IsValidIndex(Phase), void());
+
+	(*Loads)[Phase] = FMath::Max((*Loads)[Phase] - 1, 0);
+}
+
+void UAdaTickManager::HandleLeftoverSteps()
+{
+	const int32 LeftoverSteps = FMath::FloorToInt32((UnspentTimeMS + KINDA_SMALL_NUMBER) / FixedStepMS);
+	if (LeftoverSteps <= 0)
+	{
+		return;
+	}
+
+	// Pull the whole steps out of the accumulator; any fractional remainder always carries over to the next frame.
+	UnspentTimeMS = FMath::Max(UnspentTimeMS - LeftoverSteps * FixedStepMS, 0.0f);
+
+	int32 KeptSteps = 0;
+	switch (OverrunPolicy)
+	{
+		case EAdaTickOverrunPolicy::Drop:
+		{
+			break;
+		}
+		case EAdaTickOverrunPolicy::Carry:
+		{
+			KeptSteps = FMath::Min<int32>(LeftoverSteps, MaxCarriedSteps);
+			UnspentTimeMS += KeptSteps * FixedStepMS;
+			break;
+		}
+		case EAdaTickOverrunPolicy::Stretch:
+		{
+			const int32 OwedSteps = FMath::FloorToInt32((CatchUpDebtMS + KINDA_SMALL_NUMBER) / FixedStepMS);
+			KeptSteps = FMath::Clamp<int32>(MaxCarriedSteps - OwedSteps, 0, LeftoverSteps);
+			CatchUpDebtMS += KeptSteps * FixedStepMS;
+			break;
+		}
+		case EAdaTickOverrunPolicy::Collapse:
+		{
+			// Run everything we're keeping now, as a single step. Multi-step tick functions can catch up for roughly the cost of one step.
+			KeptSteps = FMath::Min<int32>(LeftoverSteps, MaxCarriedSteps);
+			if (KeptSteps > 0)
+			{
+				CollapsedStepCount += KeptSteps;
+				RunFixedStep(KeptSteps);
+			}
+			break;
+		}
+		default: break;
+	}
+
+	if (OverrunPolicy != EAdaTickOverrunPolicy::Collapse)
+	{
+		DeferredStepCount += KeptSteps;
+	}
+
+	const int32 DroppedSteps = LeftoverSteps - KeptSteps;
+	if (DroppedSteps > 0)
+	{
+		DroppedStepCount += DroppedSteps;
+		UE_LOG(LogAdaTickManager, Verbose, TEXT("%hs: Dropped %i fixed steps on frame %llu (%llu dropped in total)."), __FUNCTION__, DroppedSteps, GetCurrentFrame(), DroppedStepCount);
+	}
+}
+
+void FAdaFixedStepTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (IsValid(Target))
+	{
+		Target->AdvanceFixedSteps(DeltaTime);
+	}
+}
+
+FString FAdaFixedStepTickFunction::DiagnosticMessage()
+{
+	return TEXT("FAdaFixedStepTickFunction");
+}
+
+FName FAdaFixedStepTickFunction::DiagnosticContext(bool bDetailed)
+{
+	return FName(TEXT("AdaTickManager"));
+}
@@ -25,8 +25,9 @@ public:
 	static bool IsModifierClampingValid(const FAdaAttributeModifierSpec& Modifier);
 
 	// Create an attribute modifier delegate for a modifier which should be recalculated dynamically via delegate functions.
+	// Only mark the delegate thread safe if both functions can be called from worker threads while the game thread carries on.
 	template<typename T>
-	static FAdaAttributeModifierDelegate MakeModifierDelegate(T* Object, bool(T::*ShouldRecalcFunc)(const FGameplayTag), float(T::*RecalcFunc)(const FGameplayTag))
+	static FAdaAttributeModifierDelegate MakeModifierDelegate(T* Object, bool(T::*ShouldRecalcFunc)(const FGameplayTag), float(T::*RecalcFunc)(const FGameplayTag), const bool bThreadSafe = false)
 	{
 		static_assert(TIsDerivedFrom<T, UObject>::Value);
 
@@ -54,6 +55,7 @@ public:
 		};
 
 		NewDelegate.bIsSet = true;
+		NewDelegate.bThreadSafe = bThreadSafe;
 		NewDelegate.ShouldRecalculateModifierFunc = MoveTemp(ShouldRecalcFunctionWrapper);
 		NewDelegate.RecalculateModifierFunc = MoveTemp(RecalcFunctionWrapper);
 
@@ -4,6 +4,7 @@
 
 #include "GameplayTagContainer.h"
 #include "Data/AdaTaggedTableRow.h"
+#include "GameplayState/AdaBakedCurve.h"
 
 #include "AdaAttributeModifierTypes.generated.h"
 
@@ -118,6 +119,10 @@ struct ADAGAMEPLAY_API FAdaAttributeModifierDelegate
 public:
 	bool bIsSet = false;
 
+	// Whether the functions can be called from worker threads. Components with modifiers whose functions can't be are always ticked
+	// on the game thread.
+	bool bThreadSafe = false;
+
 	FShouldRecalculateDelegate ShouldRecalculateModifierFunc;
 	FRecalculateDelegate RecalculateModifierFunc;
 
@@ -217,6 +222,7 @@ struct ADAGAMEPLAY_API FAdaAttributeModifier
 	GENERATED_BODY()
 
 	friend class UAdaGameplayStateComponent;
+	friend struct FAdaAttributeModifierAggregate;
 
 public:
 	FAdaAttributeModifier() = default;
@@ -233,20 +239,72 @@ public:
 	bool ShouldRecalculate() const;
 	bool CanApply(const uint64& CurrentTick);
 
+	// Whether this modifier can change its attribute on a tick without anything else changing first: it applies over time,
+	// expires, or recalculates its own value. Components with none of these can stop ticking until something changes.
+	bool NeedsTicking() const;
+
+	// Whether this modifier is driven by time: it applies over time or expires. The rest of the modifiers that need ticking only recalculate their value.
+	bool IsTimeDriven() const;
+
+	// Whether this modifier recalculates its own value, and so has to be visited on every tick it's active.
+	bool RecalculatesValue() const;
+
+	// Whether recalculating this modifier's value has to happen on the game thread. Status effects recalculate through Blueprint,
+	// and delegates have to say they're thread safe.
+	bool RecalculatesOnGameThread() const;
+
+	// Whether this modifier only has to be visited on the ticks it applies or expires on, which are known ahead of time.
+	// That's duration and periodic modifiers that don't recalculate their value.
+	bool IsScheduled() const;
+
+	// The next tick a scheduled modifier has to be visited on. May already have passed, in which case it's due as soon as possible.
+	uint64 GetNextScheduledTick() const;
+
+	// Whether this modifier is folded into its attribute's running aggregate, rather than being visited when the attribute is recalculated.
+	// That's every modifier on the current value, other than overrides, which replace the value outright.
+	inline bool IsAggregated() const { return !bAffectsBase && OperationType != EAdaAttributeModOpType::Override; };
+
 	float CalculateValue();
 	void SetValue(float NewValue);
 
 	void PostApply(const uint64& CurrentTick);
+
+	// Work out, in closed form, how many times this modifier applies over the inclusive range of ticks, and whether it expires within it.
+	// The result is held on the modifier until PostApplySteps is called.
+	uint32 PrepareSteps(const uint64& FirstTick, const uint64& LastTick, bool& bOutExpires);
+
+	// Get the combined value of the given number of applications of this modifier: the sum for additive modifiers, or the product for multipliers.
+	// Curve modifiers are sampled once per application, and advance along their curve accordingly.
+	float CalculateAggregateValue(const uint32 ApplicationCount);
+
+	// Equivalent of PostApply for the applications counted by PrepareSteps.
+	void PostApplySteps();
+
+	// Move this modifier onto a new tick timeline, where OldTick maps onto NewTick and each old tick is worth Scale new ticks.
+	// Durations and intervals are scaled too, so that they keep the same length in simulation time.
+	void RescaleTicks(const uint64 OldTick, const uint64 NewTick, const double Scale);
+
+	// Map a single tick onto a new tick timeline, as above.
+	static uint64 RescaleTick(const uint64 Tick, const uint64 OldTick, const uint64 NewTick, const double Scale);
 	
 	FString ToString() const;
 
 protected:
 	void SetModifyingAttribute(const FAdaAttribute& InAttribute);
-	void SetModifierCurve(const UCurveFloat* const InModifierCurve);
+	void SetModifierCurve(const TSharedPtr<const FAdaBakedCurve>& InModifierCurve);
 
-	// #TODO(Ada.Gameplay): Replace with attribute handles?
 	FGameplayTag AffectedAttribute = FGameplayTag::EmptyTag;
 	FGameplayTag ModifyingAttribute = FGameplayTag::EmptyTag;
+
+	// Slots of the affected and modifying attributes on the owning component, resolved when this modifier is applied.
+	int32 AffectedAttributeIndex = INDEX_NONE;
+	int32 ModifyingAttributeIndex = INDEX_NONE;
+
+	// Where this modifier is in the owning component's timed or dynamic modifier list, if it needs ticking.
+	int32 TickListIndex = INDEX_NONE;
+
+	// Whether this modifier has an event waiting on the owning component's modifier schedule.
+	bool bIsOnSchedule = false;
 	
 	EAdaAttributeModApplicationType ApplicationType = EAdaAttributeModApplicationType::Instant;
 	EAdaAttributeModCalcType CalculationType = EAdaAttributeModCalcType::SetByCaller;
@@ -256,8 +314,9 @@ protected:
 	float ModifierValue = 0.0f;
 
 private:
-	// Cached curve float to look up values for curve modifiers.
-	TWeakObjectPtr<const UCurveFloat> ModifierCurve = nullptr;
+	// Baked copy of the curve float to look up values for curve modifiers.
+	// Shared with the manager's cache, so it stays valid even if the cache is rebuilt while this modifier is alive.
+	TSharedPtr<const FAdaBakedCurve> ModifierCurve = nullptr;
 
 	// The status effect that owns this modifier, if it was created by a status effect's activation.
 	TWeakObjectPtr<UAdaStatusEffect> ParentStatusEffect = nullptr;
@@ -277,8 +336,8 @@ private:
 	uint64 LastApplicationTick = 0;
 
 	// The interval, in ticks, for when we should apply this modifier.
-	// Relevant to tick-based modifiers.
-	uint8 Interval = 0;
+	// Relevant to tick-based modifiers. Wider than the spec's, as rescaling to a smaller bucket count can take it past a uint8.
+	uint32 Interval = 0;
 
 	// How many ticks we should apply this modifier for.
 	// Relevant to duration-based modifiers.
@@ -311,6 +370,11 @@ private:
 	// Whether this modifier should apply when it's expired or removed.
 	// Relevant to tick-based modifiers.
 	bool bShouldApplyOnRemoval = false;
+
+	// How many times this modifier applies over the ticks being caught up on, and the last tick it applies on.
+	// Only used while a gameplay state component is advancing multiple ticks at once.
+	uint32 PendingApplicationCount = 0;
+	uint64 PendingLastApplicationTick = 0;
 };
 
 // Handle to an active attribute modifier.
@@ -78,6 +78,50 @@ struct ADAGAMEPLAY_API FAdaAttributeInitParams
 	float TargetValueDecayRateScalar = 0.01f;
 };
 
+// Running totals of the modifiers on an attribute's current value, kept up to date as those modifiers are added, removed or change value,
+// so that recalculating the attribute doesn't have to visit every one of them.
+// Multipliers are held as the product of the non-zero multipliers and a count of zero multipliers, so that removing a zero multiplier
+// doesn't have to divide by zero.
+struct ADAGAMEPLAY_API FAdaAttributeModifierAggregate
+{
+public:
+	void Add(const FAdaAttributeModifier& Modifier);
+	void Remove(const FAdaAttributeModifier& Modifier);
+
+	// Swap the old value of a modifier that's already in this aggregate for its current value.
+	void ChangeValue(const FAdaAttributeModifier& Modifier, const float OldValue);
+
+	void Reset();
+
+	// Every update adds a little floating point error, particularly multiplying and dividing the product, so the aggregate should be
+	// rebuilt from its modifiers every so often.
+	bool NeedsRebuild() const;
+
+	// Call once the aggregate has been rebuilt from its modifiers, so that the adds it took to do so don't count towards the next rebuild.
+	inline void MarkRebuilt() { UpdatesSinceRebuild = 0; };
+
+	inline float Apply(const float BaseValue) const { return ((BaseValue + Additive) * GetMultiplier()) + PostAdditive; };
+	inline float GetMultiplier() const { return ZeroMultiplierCount > 0 ? 0.0f : Multiplier; };
+	inline const FVector2D& GetClampingDelta() const { return ClampingDelta; };
+
+private:
+	void AddValue(const EAdaAttributeModOpType OperationType, const float Value);
+	void RemoveValue(const EAdaAttributeModOpType OperationType, const float Value);
+
+	// How many updates an aggregate can take before it's rebuilt.
+	static constexpr int32 RebuildInterval = 1024;
+
+	float Additive = 0.0f;
+	float Multiplier = 1.0f;
+	float PostAdditive = 0.0f;
+	int32 ZeroMultiplierCount = 0;
+
+	FVector2D ClampingDelta = FVector2D::ZeroVector;
+
+	int32 ModifierCount = 0;
+	int32 UpdatesSinceRebuild = 0;
+};
+
 // An attribute can be any arbitrary gameplay value.
 // Common examples include health, stamina, and max move speed, but this can be extended to be practically any value seen in a wide array of games.
 // Attributes themselves are simple data storage defining a set of values and what's currently affecting them.
@@ -168,6 +212,17 @@ private:
 	// An array of handles to modifiers that are currently being applied to this attribute.
 	TArray<FAdaAttributeModifierHandle> ActiveModifiers;
 
+	// Handles to the modifiers that apply to the base value. These apply on particular ticks, so they're visited whenever this attribute
+	// is recalculated, unlike the rest, which are kept in CurrentAggregate.
+	TArray<FAdaAttributeModifierHandle> BaseModifiers;
+
+	// Running totals of the modifiers on the current value.
+	FAdaAttributeModifierAggregate CurrentAggregate;
+
+	// How many duration modifiers are on this attribute. They apply on every tick until they expire, so the attribute is recalculated
+	// on every tick while it has any, without the modifiers themselves having to be visited.
+	int32 DurationModifierCount = 0;
+
 	// Handle to an overriding modifier if one is currently being applied to this attribute.
 	FAdaAttributeModifierHandle OverridingModifier;
 
@@ -180,6 +235,9 @@ private:
 	// Whether this attribute is currently pending recalculation.
 	bool bIsDirty = false;
 
+	// How many ticks' worth of changes are pending, when catching up multiple ticks at once.
+	uint32 PendingStepCount = 0;
+
 	// Whether this attribute is currently being overridden by an override modifier or not.
 	bool bIsOverridden = false;
 };
@@ -0,0 +1,45 @@
+// Copyright Matt Bramah-Taylor, 2025. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/ArrayView.h"
+
+struct FRichCurve;
+
+// A float curve baked down into evenly spaced samples across its key range, so that sampling it is a single lerp rather than a key search.
+// Sampling outside of the key range clamps to the first or last sample, which matches constant extrapolation on the source curve.
+struct ADAGAMEPLAY_API FAdaBakedCurve
+{
+public:
+	// Bake the source curve with the fewest samples, from MinResolution up to MaxResolution, that keeps within Tolerance of it.
+	// Returns the largest error found against the source curve, which may exceed Tolerance if MaxResolution wasn't enough.
+	float Bake(const FRichCurve& SourceCurve, const int32 MinResolution, const int32 MaxResolution, const float Tolerance);
+
+	float Sample(const float Time) const;
+
+	// Sample a batch of baked curves, four at a time. Each output is the matching curve sampled at the matching time, scaled by the matching multiplier.
+	// Curves may repeat, and all of the views must be the same length.
+	static void SampleBatch(TArrayView<const FAdaBakedCurve* const> Curves, TArrayView<const float> Times, TArrayView<const float> Multipliers, TArrayView<float> OutValues);
+
+	inline int32 GetResolution() const { return Samples.Num(); };
+	inline float GetMaxError() const { return MaxError; };
+
+private:
+	void BakeSamples(const FRichCurve& SourceCurve, const float Range, const int32 Resolution);
+
+	// The largest difference between this and the source curve, checked at each key and halfway between each pair of samples.
+	float MeasureError(const FRichCurve& SourceCurve) const;
+
+	// Where along the samples the given time lies, clamped to the sampled range.
+	inline float GetSamplePosition(const float Time) const { return FMath::Clamp((Time - MinTime) * SampleRate, 0.0f, static_cast<float>(Samples.Num() - 1)); };
+
+	// Always holds at least two samples once baked.
+	TArray<float> Samples;
+
+	float MinTime = 0.0f;
+
+	// Samples per unit of curve time. Zero for curves with no range to speak of.
+	float SampleRate = 0.0f;
+
+	float MaxError = 0.0f;
+};
@@ -3,6 +3,8 @@
 #pragma once
 
 #include "Components/ActorComponent.h"
+#include "Containers/AdaSlotArray.h"
+#include "Containers/AdaTimingWheel.h"
 #include "GameFramework/AdaGameplayTagCountContainer.h"
 
 #include "GameplayState/AdaAttributeTypes.h"
@@ -17,6 +19,8 @@ DECLARE_MULTICAST_DELEGATE(FAdaOnPostFixedTick);
 
 DECLARE_LOG_CATEGORY_EXTERN(LogAdaGameplayState, Log, All);
 
+class UAdaGameplayStateManager;
+
 UCLASS(ClassGroup = (Custom), Meta = (BlueprintSpawnableComponent))
 class ADAGAMEPLAY_API UAdaGameplayStateComponent : public UActorComponent
 {
@@ -35,6 +39,10 @@ public:
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	// End UActorComponent overrides.
 
+	// Begin UObject overrides.
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+	// End UObject overrides.
+
 	/// @brief	Add an attribute to this component with some initial data.
 	/// @param	AttributeTag	The attribute we want to add.
 	/// @param	InitParams		Parameters for setting the initial state of this attribute.
@@ -101,9 +109,16 @@ public:
 	/// @brief	Add a status effect to this component.
 	/// @param	StatusEffectTag	The gameplay tag representing the status effect.
 	/// @return Handle to the newly added status effect.
-	/// @note	The handle will be invalid if the status effect failed to apply.
+	/// @note	The handle will be invalid if the status effect failed to apply. Definitions that aren't loaded yet fail to apply,
+	///			but are streamed in so that later attempts succeed; use AddStatusEffectWhenLoaded to apply them once they've loaded.
 	FAdaStatusEffectHandle AddStatusEffect(const FGameplayTag StatusEffectTag);
 
+	/// @brief	Add a status effect to this component once its definition has loaded, streaming it in if needs be.
+	/// @param	StatusEffectTag	The gameplay tag representing the status effect.
+	/// @param	OnAdded			Called with the handle to the newly added status effect. Called straight away if the definition is already loaded.
+	/// @note	The handle will be invalid if the status effect failed to load or apply, or this component went away while it was loading.
+	void AddStatusEffectWhenLoaded(const FGameplayTag StatusEffectTag, TUniqueFunction<void(const FAdaStatusEffectHandle&)>&& OnAdded = nullptr);
+
 	/// @brief	Remove a status effect from this component.
 	/// @param	StatusEffectHandle	The handle to the status effect we want to remove from this component.
 	/// @return Whether the status effect was removed successfully.
@@ -162,6 +177,29 @@ protected:
 
 	void FixedTick(const uint64& CurrentTick);
 
+	// Rough measure of how much work this component does per tick, from its active modifiers and dirty attributes.
+	int32 GetTickWorkEstimate() const;
+
+	// Whether ticking this component would do nothing until something outside of the tick changes it.
+	bool CanSleep() const;
+
+	// Whether ticking this component has to happen on the game thread, because some of its modifiers can only be recalculated there.
+	inline bool RequiresGameThreadTick() const { return GameThreadModifierCount > 0; };
+
+	// Let the gameplay state manager know this component has work to do again, if it had put it to sleep.
+	void WakeUp();
+
+	// Catch up on any frames our bucket has ticked that our tier has skipped over, so that anything we start from here starts on the current frame.
+	void CatchUpToBucket();
+
+	// Move this component onto a new tick timeline, when the length of a tick changes. See FAdaAttributeModifier::RescaleTicks.
+	void RescaleTicks(const uint64 OldTick, const uint64 NewTick, const double Scale);
+
+	// Advance this component by multiple ticks at once, ending on CurrentTick.
+	// Modifiers are applied for the number of times they'd have applied over those ticks in closed form, rather than by
+	// running each tick in turn, so catching up many ticks costs roughly the same as a single tick.
+	void FixedTick(const uint64& CurrentTick, const uint32 StepCount);
+
 	// Utility functions for finding attributes on this component.
 	FAdaAttribute* FindAttribute_Internal(const FGameplayTag AttributeTag);
 	const FAdaAttribute* FindAttribute_Internal(const FGameplayTag AttributeTag) const;
@@ -169,6 +207,16 @@ protected:
 	FAdaAttribute* FindAttributeByIndex(int32 Index);
 	const FAdaAttribute* FindAttributeByIndex(int32 Index) const;
 
+	// The slot in Attributes holding the given attribute, or INDEX_NONE if we don't have it.
+	inline int32 FindAttributeIndex(const FGameplayTag AttributeTag) const
+	{
+		const int32* const FoundIndex = AttributeIndices.Find(AttributeTag);
+		return FoundIndex ? *FoundIndex : INDEX_NONE;
+	};
+
+	// Find an attribute by a slot resolved earlier, falling back on its tag if the slot has since been given to another attribute.
+	FAdaAttribute* FindAttributeBySlot(const int32 Index, const FGameplayTag AttributeTag);
+
 	// Utility functions for finding attribute modifiers by their array index.
 	FAdaAttributeModifier* FindModifierByIndex(int32 Index);
 	const FAdaAttributeModifier*FindModifierByIndex(int32 Index) const;
@@ -180,6 +228,19 @@ protected:
 	// any references to this modifier on attributes, and any attribute dependency references.
 	bool RemoveModifier_Internal(FAdaAttributeModifier& Modifier, int32 Index);
 
+	// Add a newly cached modifier to the timed or dynamic modifier list if it needs ticking, or to the modifier schedule if it's scheduled.
+	// Static modifiers go in neither.
+	void AddToTickList(const int32 Index);
+
+	// Take a modifier out of whichever of the timed or dynamic modifier lists it's in, or off the modifier schedule.
+	void RemoveFromTickList(FAdaAttributeModifier& Modifier);
+
+	// Put a scheduled modifier on the modifier schedule for its next event, if it isn't on it already.
+	void ScheduleModifier(const int32 Index);
+
+	// Gather the scheduled modifiers with events due on or before the given tick into DueModifiers.
+	void CollectDueModifiers(const uint64 CurrentTick);
+
 	// Immediately apply an instant, permanent modifier to this attribute.
 	void ApplyImmediateModifier(FAdaAttribute& Attribute, const FAdaAttributeModifierSpec& ModifierToApply);
 
@@ -187,7 +248,11 @@ protected:
 	void ApplyOverridingModifier(FAdaAttribute& Attribute, const FAdaAttributeModifier& Modifier, const int32 ModifierIndex);
 
 	// Recalculate the value of an attribute from its modifiers.
-	void RecalculateAttribute(FAdaAttribute& Attribute, const uint64& CurrentTick);
+	// When StepCount is greater than 1, applies the modifier application counts gathered by the multi-step FixedTick.
+	void RecalculateAttribute(FAdaAttribute& Attribute, const uint64& CurrentTick, const uint32 StepCount = 1);
+
+	// Rebuild an attribute's running aggregate from scratch, from the modifiers on its current value.
+	void RebuildAggregate(FAdaAttribute& Attribute);
 
 	// Check if attribute A depends on attribute B. Used to prevent circular dependencies.
 	bool DoesAttributeDependOnOther(const FGameplayTag AttributeTag, const FGameplayTag OtherAttributeTag) const;
@@ -195,6 +260,18 @@ protected:
 	// Let attributes, effects and delegate subscribers know an attribute's value has changed.
 	void NotifyAttributeChanged(FAdaAttribute& Attribute, const float OldBase, const float OldCurrent);
 
+	// Broadcast the delegates for an attribute changing value.
+	void BroadcastAttributeChanged(FAdaAttribute& Attribute, const float NewBase, const float NewCurrent, const float OldBase, const float OldCurrent);
+
+	void BroadcastPostFixedTick();
+
+	// Replay any broadcasts that were captured while this component was being ticked off the game thread, in the order they were made.
+	void FlushDeferredNotifications();
+
+	// If this component is being ticked in the background, wait for that to finish before the game thread touches it.
+	// Everything the game thread can call to read or change the component calls this before touching any of its state.
+	void WaitForPipelinedTick() const;
+
 	// Get an identifier for a new attribute.
 	// Designed to overflow and avoid the error case of INDEX_NONE.
 	int32 GetNextAttributeId();
@@ -207,23 +284,48 @@ protected:
 	// Designed to overflow and avoid the error case of INDEX_NONE.
 	int32 GetNextStatusEffectId();
 
+	// Apply a modifier spec that has already been validated. Curve modifiers use the given baked curve if there is one, rather than looking theirs up.
+	FAdaAttributeModifierHandle ModifyAttribute_Internal(const FGameplayTag AttributeTag, const FAdaAttributeModifierSpec& ModifierToApply, const TSharedPtr<const FAdaBakedCurve>& ModifierCurve);
+
 	// Remove the specified status effect from this component.
 	bool RemoveStatusEffect_Internal(const int32 Index);
 
 protected:
-	// #TODO(Ada.Gameplay.Optimisation): Reserve memory & define allocator?
-	TSparseArray<FAdaAttribute> Attributes;
+	// Attributes, modifiers and status effects are packed together for iteration, with slot indices that stay stable for their handles.
+	TAdaSlotArray<FAdaAttribute> Attributes;
+
+	// The slot in Attributes for each attribute, so that finding one by tag doesn't have to scan them all.
+	TMap<FGameplayTag, int32> AttributeIndices;
+
+	// Modifiers come and go far more often than attributes, so give memory back once they've mostly expired.
+	TAdaSlotArray<FAdaAttributeModifier> ActiveModifiers = TAdaSlotArray<FAdaAttributeModifier>(EAdaSlotArrayShrinkPolicy::WhenHalfEmpty);
+
+	// Slots in ActiveModifiers of the modifiers that have to be visited every tick, split by what drives them.
+	// Static modifiers are in neither, and only touch their attribute when they're added or removed. Scheduled modifiers are in neither
+	// either, and are only visited when their next event comes due on ModifierSchedule.
+	TArray<int32> TimedModifiers;
+	TArray<int32> DynamicModifiers;
 
-	// #TODO(Ada.Gameplay.Optimisation) TSparseArray has poorer performance for iteration due to non-contiguous allocation.
-	// FAdaAttributeModifier is a nullable type and should be trivially relocatable, so we can bypass both the pointer and index
-	// instability of TArray by wrapping it in a collection type that allocates and frees instances for us.
-	// That would mean either never shrinking or implementing our own shrinking method.
-	// A generic collection type for this would prove beneficial.
-	TSparseArray<FAdaAttributeModifier> ActiveModifiers;
+	// How many of the modifiers in the tick lists have to be recalculated on the game thread.
+	int32 GameThreadModifierCount = 0;
 
-	// #TODO(Ada.Gameplay.Optimisation) TSparseArray has poorer performance for iteration due to non-contiguous allocation.
-	// See above, use a collection of UObject pointers and then we can do away with TStrongObjectPtr.
-	TSparseArray<TStrongObjectPtr<UAdaStatusEffect>> ActiveStatusEffects;
+	// A scheduled modifier's event on ModifierSchedule. Modifiers removed before their event comes due are told apart by their identifier.
+	struct FScheduledModifier
+	{
+		int32 Index = INDEX_NONE;
+		int32 Identifier = INDEX_NONE;
+	};
+
+	TAdaTimingWheel<FScheduledModifier> ModifierSchedule;
+
+	// How many modifiers have an event waiting on ModifierSchedule, not counting any that have been removed since.
+	int32 ScheduledModifierCount = 0;
+
+	// Slots of the scheduled modifiers that have come due on the current tick.
+	TArray<int32> DueModifiers;
+
+	// Kept alive through AddReferencedObjects.
+	TAdaSlotArray<TObjectPtr<UAdaStatusEffect>> ActiveStatusEffects;
 
 	FAdaGameplayTagCountContainer ActiveStates;
 	FAdaGameplayTagCountContainer ActiveStatusEffectTags;
@@ -231,4 +333,18 @@ protected:
 	uint64 LatestTick = 0;
 	int32 LatestModifierId = 0;
 	int32 LatestStatusEffectId = 0;
+
+	// While set, delegate broadcasts are captured into DeferredNotifications rather than made immediately.
+	// Set by the gameplay state manager while it ticks this component on a worker thread.
+	bool bDeferNotifications = false;
+	TArray<TUniqueFunction<void()>> DeferredNotifications;
+
+	// The manager currently ticking this component in the background, if any. Only read and written on the game thread.
+	UAdaGameplayStateManager* PipelinedTickOwner = nullptr;
+
+	// Whether the component was idle at the end of its last tick. Cleared by anything that gives it more work to do.
+	bool bReadyToSleep = false;
+
+	// Whether the gameplay state manager has taken this component out of its tick buckets.
+	bool bIsAsleep = false;
 };
\ No newline at end of file
@@ -6,18 +6,33 @@
 #include "Components/ActorComponent.h"
 #include "DataRegistryId.h"
 #include "UObject/ObjectKey.h"
+#include "UObject/PrimaryAssetId.h"
+#include "Tasks/Task.h"
+#include "GameplayState/AdaBakedCurve.h"
 
 #include "AdaGameplayStateManager.generated.h"
 
 struct FAdaAttributeSet;
+struct FAdaCompiledStatusEffect;
 class UAdaGameplayStateComponent;
 class UAdaStatusEffectDefinition;
 class UCurveFloat;
 
-#define ADA_TICK_BUCKET_COUNT 15
-
 DECLARE_LOG_CATEGORY_EXTERN(LogAdaGameplayStateManager, Log, All);
 
+// How often a gameplay state component ticks, relative to the rate of its tick bucket.
+UENUM(BlueprintType)
+enum class EAdaGameplayStateTickTier : uint8
+{
+	Full		UMETA(Tooltip = "Ticks every time its bucket is ticked."),
+	Half		UMETA(Tooltip = "Ticks every other time its bucket is ticked."),
+	Quarter		UMETA(Tooltip = "Ticks every fourth time its bucket is ticked."),
+	Dormant		UMETA(Tooltip = "Doesn't tick. Catches up on everything it missed once it moves to another tier.")
+};
+
+// Game-provided function for scoring how significant a component is, and so which tier it should tick in.
+DECLARE_DELEGATE_RetVal_OneParam(EAdaGameplayStateTickTier, FAdaGameplayStateTickTierScorer, const UAdaGameplayStateComponent* /*StateComponent*/);
+
 UCLASS()
 class ADAGAMEPLAY_API UAdaGameplayStateManager : public UActorComponent
 {
@@ -30,6 +45,7 @@ public:
 	virtual void InitializeComponent() override;
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 	// End UActorComponent overrides.
 
 	void RegisterStateComponent(UAdaGameplayStateComponent* StateComponent);
@@ -38,16 +54,119 @@ public:
 	const UAdaStatusEffectDefinition* GetStatusEffectDefinition(const FGameplayTag EffectTag) const;
 	void GetAllStatusEffectTags(TArray<FGameplayTag>& OutTags) const;
 
+	/// @brief	Get the compiled runtime form of a status effect definition, as used to apply it.
+	TSharedPtr<const FAdaCompiledStatusEffect> GetCompiledStatusEffect(const FGameplayTag EffectTag) const;
+
+	inline bool IsStatusEffectLoaded(const FGameplayTag EffectTag) const { return CompiledStatusEffects.Contains(EffectTag); };
+
+	/// @brief	Stream in a status effect definition that isn't loaded yet.
+	/// @param	OnLoaded	Called once the definition has finished loading, or has failed to. Called straight away if it's already loaded.
+	/// @note	Streamed definitions are released again once they've gone unused for StatusEffectReleaseDelaySeconds.
+	void RequestStatusEffectLoad(const FGameplayTag EffectTag, TUniqueFunction<void(const bool /*bLoaded*/)>&& OnLoaded = nullptr);
+
+	/// @brief	Release any streamed status effect definitions that have gone unused for long enough.
+	/// @note	Called automatically at the end of each round of the tick buckets.
+	void ReleaseUnusedStatusEffects();
+
+	/// @brief	Log how long loading status effect definitions has taken, and how much memory they're using.
+	void DumpStatusEffectLoads() const;
+
 	const UCurveFloat* GetCurveForModifier(const FGameplayTag CurveTag) const;
+
+	/// @brief	Get the baked lookup table for a curve modifier's curve.
+	/// @note	Every curve in the curve modifier registry is baked on BeginPlay. Curves cached by the registry after that are baked the first time they're asked for.
+	TSharedPtr<const FAdaBakedCurve> GetBakedCurveForModifier(const FGameplayTag CurveTag);
+
 	const FAdaAttributeSet* GetAttributeSet(const FGameplayTag SetTag) const;
 
+	/// @brief	Log the load of each tick bucket, along with how many components it holds.
+	void DumpBucketLoads() const;
+
+	inline int32 GetTickBucketCount() const { return TickBuckets.Num(); };
+
+	/// @brief	Set the function used to sort components into tick tiers.
+	///			Every component is rescored once every TickTierUpdateRounds rounds of the tick buckets. Without a scorer, all components tick in full.
+	void SetTickTierScorer(const FAdaGameplayStateTickTierScorer& InScorer);
+
+	/// @brief	Move a component into a specific tick tier, until it's next rescored.
+	/// @note	Components that drop tiers let their ticks build up, and catch up on them all at once when they're next due.
+	///			Modifier durations and intervals are therefore unaffected by a component's tier, only how often they're evaluated.
+	void SetComponentTickTier(const UAdaGameplayStateComponent* StateComponent, const EAdaGameplayStateTickTier Tier);
+	EAdaGameplayStateTickTier GetComponentTickTier(const UAdaGameplayStateComponent* StateComponent) const;
+
+	/// @brief	Wait for any bucket ticks still running in the background, then broadcast their notifications and finish the buckets off.
+	/// @note	Called automatically at the start of each fixed step, before garbage collection, and whenever the game thread
+	///			accesses a component that's still being ticked. Only needs calling directly to force pipelined results to land early.
+	void CompletePipelinedTicks();
+
+	/// @brief	Whether the calling thread is currently running a pipelined bucket tick.
+	static bool IsRunningPipelinedTick();
+
+	/// @brief	Put a sleeping component back into its tick bucket.
+	/// @note	Components are put to sleep once they finish a tick with nothing left that changes over time, and wake themselves
+	///			up as soon as they're given more work to do, so this shouldn't need calling from outside of the component.
+	void WakeStateComponent(UAdaGameplayStateComponent* StateComponent);
+
+	/// @brief	Tick a component through any bucket frames it's skipped over because of its tier, so that it's on its bucket's frame.
+	/// @note	Components call this before they start anything new, so that it starts on the current frame rather than being caught
+	///			up on frames from before it existed the next time the component ticks.
+	void CatchUpStateComponent(UAdaGameplayStateComponent* StateComponent);
+
+	inline int32 GetSleepingComponentCount() const { return SleepingEntries.Num(); };
+
 protected:
-	void FixedTick(const uint64& CurrentFrame);
+	// Finish any bookkeeping that has to wait until every bucket is on the same frame.
+	void OnRoundFinished();
+
+	// Called once every bucket has had its turn. Finishes the round now, or once any buckets still in flight have finished.
+	void FinishRound();
+
+	// Tick the buckets due over the given number of fixed steps. Each step ticks the next bucket in turn, so when catching up
+	// on several steps at once, each bucket is ticked once for all of the turns it would have had.
+	void FixedTick(const uint64& CurrentFrame, const uint32 StepCount);
+
+	// Advance every component in the bucket by the given number of its own ticks.
+	void TickBucket(const uint8 BucketIndex, const uint32 StepCount);
 
-	void IncrementAssignmentCounter();
 	void IncrementTickCounter();
 
+	// Move a few components from the most loaded bucket to the least loaded one.
+	// Only safe to call between rounds, when every bucket is on the same frame.
+	void RebalanceBuckets();
+
+	uint8 FindLeastLoadedBucket() const;
+
+	// Rescore every component with the tick tier scorer.
+	void UpdateTickTiers();
+
+	// The number of tick buckets we should have: from Ada.GameplayState.TickBucketCount if it's set, otherwise from the developer settings.
+	static int32 GetDesiredTickBucketCount();
+
+	// Redistribute every component across the given number of buckets.
+	// Bucket frames and component timings are rescaled so that modifier durations keep their length in simulation time.
+	// Only safe to call between rounds, when every bucket is on the same frame.
+	void ResizeTickBuckets(const int32 NewBucketCount);
+
+	// Estimate the cost of a component we haven't measured yet from the work it has queued up.
+	float EstimateComponentCost(const UAdaGameplayStateComponent* const StateComponent) const;
+
+	// Gather the status effects to load up front, from our own preloads and the developer settings' preloads for the current map.
+	void GatherPreloadedStatusEffects(TArray<FPrimaryAssetId>& OutAssetIds) const;
+
 	void OnStatusEffectDefsLoaded();
+	void OnStatusEffectDefStreamed(const FGameplayTag EffectTag);
+
+	// Add a loaded definition to the definitions we can apply, returning its estimated size in bytes.
+	int64 AddStatusEffectDefinition(UAdaStatusEffectDefinition& Definition);
+
+	// Build the runtime form of a definition, validating its modifiers and resolving their curves up front.
+	TSharedRef<const FAdaCompiledStatusEffect> CompileStatusEffect(const UAdaStatusEffectDefinition& Definition);
+
+	// Bake every curve currently cached by the curve modifier registry.
+	void BakeCurveModifiers();
+
+	// Bake the curve with the tolerances from the developer settings, and cache it under the given tag.
+	TSharedPtr<const FAdaBakedCurve> BakeModifierCurve(const FGameplayTag CurveTag, const UCurveFloat* const Curve);
 
 protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Data")
@@ -56,18 +175,225 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Data")
 	FDataRegistryType AttributeSetRegistry = "AttributeSets";
 
+	// Status effects to load up front when not preloading every status effect. Parent tags preload every status effect beneath them.
+	// The manager is owned by the game state, so this can differ per game mode.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Data", Meta = (Categories = "StatusEffect.Id"))
+	FGameplayTagContainer PreloadedStatusEffects;
+
+	// The maximum number of components we'll move between tick buckets each time every bucket has been ticked.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Tick Buckets", Meta = (ClampMin = 0))
+	int32 MaxBucketMigrationsPerRound = 4;
+
+	// How much more loaded than the least loaded bucket, as a fraction of its load, the most loaded bucket must be before we move components.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Tick Buckets", Meta = (ClampMin = 0.0))
+	float BucketImbalanceThreshold = 0.25f;
+
+	// Whether to tick the components in a bucket across worker threads.
+	// Delegate broadcasts made while ticking are captured per component, and replayed on the calling thread in bucket order once every component has finished.
+	// Modifiers calculated by delegate must be safe to evaluate off the game thread when this is enabled.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Tick Buckets")
+	bool bTickBucketsInParallel = false;
+
+	// Buckets with this many components or fewer are always ticked serially, as the overhead of going wide isn't worth it.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Tick Buckets", Meta = (EditCondition = "bTickBucketsInParallel", ClampMin = 1))
+	int32 MinComponentsPerParallelTask = 8;
+
+	// Whether to tick buckets in the background, pipelined with the game thread.
+	// A bucket's tick is started at the end of the fixed step it's due on, and joined at the start of the next one, so attribute
+	// changes land one fixed step late, and their notifications are broadcast on the game thread when they land.
+	// The game thread is free to keep working in the meantime, but accessing a component that's still being ticked will wait for its bucket to finish.
+	// As with parallel ticking, modifiers calculated by delegate must be safe to evaluate off the game thread when this is enabled.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Tick Buckets")
+	bool bPipelineBucketTicks = false;
+
+	// Whether to spread each bucket's components across the engine frames between fixed steps, rather than ticking them all on the step.
+	// When rendering faster than the fixed step rate, this keeps the cost per engine frame flat instead of landing it all on one frame in several.
+	// Components are still ticked up to the same frame, in the same order; the bucket only moves on to its next frame once all of them have been.
+	// Pipelined bucket ticks take precedence over this.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Tick Buckets")
+	bool bSpreadBucketsAcrossFrames = false;
+
+	// Whether idle components are taken out of their tick buckets until they're given more work to do.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Tick Buckets")
+	bool bAllowComponentsToSleep = true;
+
+	// How many rounds of the tick buckets pass between each rescoring of components' tick tiers.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Tick Buckets", Meta = (ClampMin = 1))
+	int32 TickTierUpdateRounds = 4;
+
 private:
+	struct FTickBucketEntry
+	{
+		TWeakObjectPtr<UAdaGameplayStateComponent> Component;
+		FObjectKey ComponentKey;
+
+		// Smoothed wall time spent ticking this component, in milliseconds. Estimated until we've ticked it at least once.
+		float CostMS = 0.0f;
+		bool bHasMeasuredCost = false;
+
+		// The first bucket frame this component hasn't yet been ticked for.
+		uint64 NextFrame = 0;
+
+		EAdaGameplayStateTickTier Tier = EAdaGameplayStateTickTier::Full;
+
+		// Cost of this component averaged over its bucket's ticks, taking its tier into account.
+		float GetEffectiveCostMS() const;
+	};
+
+	FTickBucketEntry* FindEntry(const UAdaGameplayStateComponent* StateComponent);
+
 	struct FTickBucket
 	{
-		TArray<TWeakObjectPtr<UAdaGameplayStateComponent>> Components;
+		TArray<FTickBucketEntry> Components;
 		uint64 CurrentFrame = 0;
+
+		// Sum of the costs of every component in this bucket.
+		float LoadMS = 0.0f;
+
+		// Wall time spent ticking this bucket the last time it was ticked.
+		float LastTickMS = 0.0f;
+	};
+
+	// A component being ticked off the game thread.
+	struct FComponentTickItem
+	{
+		UAdaGameplayStateComponent* Component = nullptr;
+		int32 EntryIndex = INDEX_NONE;
+		uint32 PendingSteps = 0;
+		float CostMS = 0.0f;
+
+		// Whether the component has to be ticked on the game thread anyway, and so is left out of the work handed to other threads.
+		bool bGameThread = false;
 	};
+
+	// A bucket tick running in the background, waiting to be joined.
+	struct FPipelinedBucketTick
+	{
+		uint8 BucketIndex = 0;
+		uint32 StepCount = 0;
+		TArray<FComponentTickItem> Items;
+		UE::Tasks::FTask Task;
+	};
+
+	// A bucket tick being spread across engine frames, waiting to be finished.
+	struct FSpreadBucketTick
+	{
+		uint8 BucketIndex = 0;
+		uint32 StepCount = 0;
+
+		// The next entry in the bucket to tick, and the entry to stop before.
+		int32 NextIndex = 0;
+		int32 EndIndex = 0;
+
+		// Wall time spent ticking this bucket so far.
+		float ElapsedMS = 0.0f;
+	};
+
+	// Tick the components in the given range of the bucket, serially or across worker threads.
+	void TickBucketRange(FTickBucket& BucketToTick, const uint64 LastFrame, const int32 StartIndex, const int32 EndIndex);
+
+	// Tick the components in the given range of the bucket across worker threads.
+	void TickBucketInParallel(FTickBucket& BucketToTick, const uint64 LastFrame, const int32 StartIndex, const int32 EndIndex);
+
+	// Tick this engine frame's share of the components in spread bucket ticks.
+	void TickSpreadBuckets(const float DeltaSeconds);
+
+	// Tick every component left in spread bucket ticks, and finish the buckets off.
+	void CompleteSpreadBucketTicks();
+
+	// Tick up to the given number of components from spread bucket ticks, in the order the buckets were started.
+	void TickSpreadBucketComponents(int32 ComponentBudget);
+
+	// Whether any buckets are partway through being ticked, in the background or across engine frames.
+	bool HasBucketTicksInFlight() const;
+
+	// Run the end of round bookkeeping we put off while buckets were in flight, once they've all finished.
+	void FinishPendingRound();
+
+	// Start ticking the bucket in the background. It'll be finished off by the next call to CompletePipelinedTicks.
+	void LaunchPipelinedBucketTick(const uint8 BucketIndex, const uint32 StepCount);
+
+	// Collect the components in the bucket that are due to be ticked, and have them hold on to their broadcasts until we flush them.
+	// Components that can only be ticked on the game thread are marked as such.
+	void GatherDueComponents(FTickBucket& BucketToTick, const uint64 LastFrame, const int32 StartIndex, const int32 EndIndex, TArray<FComponentTickItem>& OutItems);
+
+	// Tick the gathered components that have to be ticked on the game thread, before the rest are handed off.
+	void TickGameThreadItems(TArrayView<FComponentTickItem> Items, const uint64 LastFrame);
+
+	// Broadcast everything the components held on to while being ticked, in bucket order, and record how long they took.
+	void FlushTickedComponents(FTickBucket& BucketToTick, const TArray<FComponentTickItem>& Items);
+
+	// Move the bucket on by the number of steps it was ticked for, and clean up any components that went away while ticking.
+	void FinishBucketTick(const uint8 BucketIndex, const uint32 StepCount);
+
+	// If the entry is due to be ticked by LastFrame, mark it as ticked and return how many frames it needs to catch up on. Otherwise returns 0.
+	static uint32 ConsumePendingSteps(FTickBucketEntry& Entry, const uint64 LastFrame);
+
+	// Tick the component up to LastFrame, returning how long it took in milliseconds.
+	static float TickStateComponent(UAdaGameplayStateComponent* const Component, const uint64 LastFrame, const uint32 PendingSteps);
+
+	static void RecordComponentCost(FTickBucketEntry& Entry, const float CostMS);
 	
-	TStaticArray<FTickBucket, ADA_TICK_BUCKET_COUNT> TickBuckets;
+	TArray<FTickBucket> TickBuckets;
 	TMap<FObjectKey, uint8> ComponentToBucketMap;
 
 	uint8 NextBucketToTick = 0;
-	uint8 NextBucketToAssign = 0;
+
+	// Whether we're currently ticking a bucket. Unregistered components are nulled out rather than removed while this is set.
+	bool bIsTickingBucket = false;
+
+	// Learned cost of a single unit of component work, used to estimate the cost of newly registered components.
+	float CostPerWorkUnitMS = 0.001f;
+
+	FAdaGameplayStateTickTierScorer TickTierScorer;
+
+	// Entries for components that have been taken out of their buckets while idle. They keep their bucket in ComponentToBucketMap.
+	TMap<FObjectKey, FTickBucketEntry> SleepingEntries;
+
+	// Bucket ticks started at the end of the last fixed step, still to be joined.
+	TArray<FPipelinedBucketTick> PipelinedBucketTicks;
+
+	// Bucket ticks started on a fixed step, being spread across the engine frames until the next one.
+	TArray<FSpreadBucketTick> SpreadBucketTicks;
+
+	// Whether a round finished while bucket ticks were still in flight, so we owe it an OnRoundFinished once they've finished.
+	bool bRoundFinishPending = false;
+
+	FDelegateHandle PreGarbageCollectHandle;
+
+	// Rounds of the tick buckets since components were last rescored.
+	int32 RoundsSinceTickTierUpdate = 0;
 
 	TMap<FGameplayTag, TObjectPtr<const UAdaStatusEffectDefinition>> LoadedStatusEffectDefinitions;
+	TMap<FGameplayTag, TSharedRef<const FAdaCompiledStatusEffect>> CompiledStatusEffects;
+
+	// A status effect definition being streamed in, and everything waiting on it.
+	struct FPendingStatusEffectLoad
+	{
+		double StartTime = 0.0;
+		TArray<TUniqueFunction<void(const bool)>> Callbacks;
+	};
+
+	TMap<FGameplayTag, FPendingStatusEffectLoad> PendingStatusEffectLoads;
+
+	struct FStreamedStatusEffect
+	{
+		// The last time we saw any live instances of this status effect.
+		double LastUsedTime = 0.0;
+		int64 SizeBytes = 0;
+	};
+
+	// Status effect definitions that were streamed in on demand. Preloaded definitions aren't tracked, as they're never released.
+	TMap<FGameplayTag, FStreamedStatusEffect> StreamedStatusEffects;
+
+	// When we started loading the preloaded status effect definitions.
+	double PreloadStartTime = 0.0;
+
+	// Load telemetry, for DumpStatusEffectLoads.
+	int32 StatusEffectLoadCount = 0;
+	int32 StatusEffectReleaseCount = 0;
+	double StatusEffectLoadSeconds = 0.0;
+	int64 LoadedStatusEffectBytes = 0;
+
+	TMap<FGameplayTag, TSharedRef<const FAdaBakedCurve>> BakedModifierCurves;
 };
@@ -0,0 +1,49 @@
+// Copyright Matt Bramah-Taylor, 2025. All Rights Reserved.
+
+#pragma once
+
+#include "Engine/DeveloperSettings.h"
+#include "GameplayTagContainer.h"
+#include "AdaGameplayStateSettings.generated.h"
+
+UCLASS(Config = Game, DefaultConfig)
+class ADAGAMEPLAY_API UAdaGameplayStateSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UAdaGameplayStateSettings() {};
+
+	/// The number of buckets gameplay state components are spread across. One bucket is ticked per fixed step.
+	/// More buckets means less work per fixed step, but each component is ticked less often.
+	/// Can be overridden at runtime with Ada.GameplayState.TickBucketCount.
+	UPROPERTY(Config, EditAnywhere, Category = "Tick Buckets", Meta = (ClampMin = 1, ClampMax = 255))
+	int32 TickBucketCount = 15;
+
+	/// The fewest samples a curve modifier's curve is baked into.
+	UPROPERTY(Config, EditAnywhere, Category = "Curve Modifiers", Meta = (ClampMin = 2))
+	int32 MinCurveBakeResolution = 32;
+
+	/// The most samples a curve modifier's curve is baked into. Curves that can't be baked within tolerance at this resolution log a warning.
+	UPROPERTY(Config, EditAnywhere, Category = "Curve Modifiers", Meta = (ClampMin = 2))
+	int32 MaxCurveBakeResolution = 1024;
+
+	/// How far a baked curve may stray from its source curve. Baking doubles the resolution, starting from the minimum, until it's within this.
+	UPROPERTY(Config, EditAnywhere, Category = "Curve Modifiers", Meta = (ClampMin = 0.0))
+	float CurveBakeTolerance = 0.001f;
+
+	/// Whether to load every status effect definition in the project when the gameplay state manager initialises.
+	/// When disabled, only the definitions in the preload manifests are loaded up front, and the rest are streamed in when they're first applied.
+	UPROPERTY(Config, EditAnywhere, Category = "Status Effects")
+	bool bPreloadAllStatusEffects = true;
+
+	/// Status effects to load up front for specific maps, on top of the gameplay state manager's own preloaded status effects.
+	/// Parent tags preload every status effect beneath them.
+	UPROPERTY(Config, EditAnywhere, Category = "Status Effects", Meta = (EditCondition = "!bPreloadAllStatusEffects", Categories = "StatusEffect.Id"))
+	TMap<TSoftObjectPtr<UWorld>, FGameplayTagContainer> MapStatusEffectPreloads;
+
+	/// How long a streamed status effect definition must go without any live instances before it's released.
+	/// Preloaded definitions are never released.
+	UPROPERTY(Config, EditAnywhere, Category = "Status Effects", Meta = (EditCondition = "!bPreloadAllStatusEffects", ClampMin = 0.0, Units = "s"))
+	float StatusEffectReleaseDelaySeconds = 30.0f;
+};
@@ -7,6 +7,7 @@
 #include "AdaStatusEffect.generated.h"
 
 struct FAdaAttributeModifierHandle;
+struct FAdaCompiledStatusEffect;
 
 UCLASS(Blueprintable)
 class ADAGAMEPLAY_API UAdaStatusEffect : public UObject
@@ -48,4 +49,7 @@ protected:
 	FGameplayTagContainer TagCategories = FGameplayTagContainer::EmptyContainer;
 
 	TArray<FAdaAttributeModifierHandle> ActiveModifierHandles;
+
+	// The compiled definition this effect was applied from.
+	TSharedPtr<const FAdaCompiledStatusEffect> CompiledDefinition = nullptr;
 };
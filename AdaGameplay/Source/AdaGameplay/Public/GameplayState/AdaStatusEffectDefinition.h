@@ -72,4 +72,35 @@ public:
 	// List of attribute modifiers that this status effect should apply to the target component.
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Modifiers", Meta = (ForceInlineRow))
 	TMap<FGameplayTag, FAdaAttributeModifierSpec> Modifiers;
+};
+
+// A status effect definition's modifier, pre-validated, with anything it needs from the gameplay state manager already resolved.
+struct FAdaCompiledStatusEffectModifier
+{
+	FGameplayTag AttributeTag = FGameplayTag::EmptyTag;
+	FAdaAttributeModifierSpec ModifierSpec;
+
+	// The baked curve for curve modifiers, so that applying them doesn't have to look it up.
+	TSharedPtr<const FAdaBakedCurve> ModifierCurve = nullptr;
+};
+
+// The immutable runtime form of a status effect definition, compiled by the gameplay state manager once definitions have loaded.
+// Live status effects keep hold of the one they were applied from, so removing them doesn't have to look their definition up again.
+struct FAdaCompiledStatusEffect
+{
+	FGameplayTag EffectTag = FGameplayTag::EmptyTag;
+	FGameplayTagContainer TagCategories = FGameplayTagContainer::EmptyContainer;
+	TSubclassOf<UAdaStatusEffect> Implementation = nullptr;
+
+	FGameplayTagContainer StateTagsToAdd = FGameplayTagContainer::EmptyContainer;
+	FGameplayTagContainer BlockingTags = FGameplayTagContainer::EmptyContainer;
+	FGameplayTagContainer EnablingTags = FGameplayTagContainer::EmptyContainer;
+	bool bCanStack = true;
+
+	FGameplayTagContainer EffectsToCancel = FGameplayTagContainer::EmptyContainer;
+	FGameplayTagContainer EffectTypesToCancel = FGameplayTagContainer::EmptyContainer;
+	bool bCancelsEffects = false;
+
+	// Only holds modifiers that passed validation when compiled.
+	TArray<FAdaCompiledStatusEffectModifier> Modifiers;
 };
\ No newline at end of file
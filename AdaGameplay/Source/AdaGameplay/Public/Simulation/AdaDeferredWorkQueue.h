@@ -0,0 +1,132 @@
+// Copyright Matt Bramah-Taylor, 2025. All Rights Reserved.
+
+#pragma once
+
+#include <atomic>
+
+#include "Containers/RingBuffer.h"
+#include "Containers/StaticArray.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+#include "AdaDeferredWorkQueue.generated.h"
+
+UENUM()
+enum class EAdaDeferredWorkPriority : uint8
+{
+	High,
+	Normal,
+	Low,
+	Count		UMETA(Hidden)
+};
+
+// Context passed to deferred work items each time they're run, used to decide when to yield.
+struct ADAGAMEPLAY_API FAdaDeferredWorkContext
+{
+	// Whether the work item should stop and return, having used up the queue's budget for this step.
+	inline bool ShouldYield() const { return FPlatformTime::Seconds() >= DeadlineSeconds; };
+
+	// The fixed frame the work is being run on.
+	uint64 CurrentFrame = 0;
+
+	// The point in time, in platform seconds, past which the work item should yield.
+	double DeadlineSeconds = 0.0;
+};
+
+// A resumable unit of deferred work. Returns true once the work has been completed, or false if it should be resumed on a later step.
+using FAdaDeferredWork = TFunction<bool(const FAdaDeferredWorkContext&)>;
+
+// Handle to a work item submitted to the deferred work queue.
+USTRUCT()
+struct ADAGAMEPLAY_API FAdaDeferredWorkHandle
+{
+	GENERATED_BODY()
+
+	friend class FAdaDeferredWorkQueue;
+
+public:
+	inline bool IsValid() const { return Identifier != 0; };
+	inline void Invalidate() { Identifier = 0; };
+
+private:
+	uint64 Identifier = 0;
+};
+
+// Snapshot of the state of the deferred work queue.
+USTRUCT()
+struct ADAGAMEPLAY_API FAdaDeferredWorkStats
+{
+	GENERATED_BODY()
+
+public:
+	// Number of work items waiting in the queue, per priority.
+	TStaticArray<int32, static_cast<uint8>(EAdaDeferredWorkPriority::Count)> QueueDepths = TStaticArray<int32, static_cast<uint8>(EAdaDeferredWorkPriority::Count)>(InPlace, 0);
+
+	uint64 CompletedCount = 0;
+	uint64 CancelledCount = 0;
+
+	// Time from submission to completion, averaged over all completed work items.
+	double MeanLatencyMS = 0.0;
+	double MaxLatencyMS = 0.0;
+
+	// Fixed steps from submission to completion, averaged over all completed work items.
+	double MeanLatencySteps = 0.0;
+	uint64 MaxLatencySteps = 0;
+};
+
+// Budgeted queue of resumable work, drained a little at a time on each fixed step.
+// Higher priority work is always run before lower priority work; within a priority, work is run in submission order, with
+// unfinished items going to the back of the queue so that a single long-running item can't starve the others.
+class ADAGAMEPLAY_API FAdaDeferredWorkQueue
+{
+public:
+	/// @brief	Add a work item to the queue.
+	/// @param	Work		The work to run. Will be called repeatedly on later steps until it returns true.
+	/// @param	Priority	The priority of this work relative to other work in the queue.
+	/// @param	Owner		Optional object that owns this work. The work will be discarded if the owner is destroyed.
+	/// @return	A handle that can be used to cancel the work.
+	FAdaDeferredWorkHandle Submit(FAdaDeferredWork&& Work, const EAdaDeferredWorkPriority Priority, const UObject* const Owner, const uint64 CurrentFrame);
+
+	/// @brief	Add a work item to the queue under a handle that was reserved for it.
+	void Submit(FAdaDeferredWork&& Work, const EAdaDeferredWorkPriority Priority, const UObject* const Owner, const uint64 CurrentFrame, const FAdaDeferredWorkHandle& ReservedHandle);
+
+	/// @brief	Reserve a handle for work that will be submitted later. Safe to call from any thread, for work that's handed over
+	///			to the thread that owns the queue before being submitted.
+	FAdaDeferredWorkHandle ReserveHandle();
+
+	/// @brief	Cancel a work item, if it hasn't already completed.
+	void Cancel(FAdaDeferredWorkHandle& Handle);
+
+	/// @brief	Run queued work until the given budget is used up.
+	void Drain(const uint64 CurrentFrame, const float BudgetMS);
+
+	/// @brief	Discard all queued work.
+	void Reset();
+
+	inline const FAdaDeferredWorkStats& GetStats() const { return Stats; };
+	int32 Num() const;
+
+private:
+	struct FWorkItem
+	{
+		FAdaDeferredWork Work;
+		TWeakObjectPtr<const UObject> Owner;
+		uint64 Identifier = 0;
+		uint64 SubmitFrame = 0;
+		double SubmitSeconds = 0.0;
+		bool bHasOwner = false;
+	};
+
+	void RecordCompletion(const FWorkItem& Item, const uint64 CurrentFrame);
+
+	TStaticArray<TRingBuffer<FWorkItem>, static_cast<uint8>(EAdaDeferredWorkPriority::Count)> Queues;
+
+	// Work that was cancelled while still in a queue. We skip these lazily when we reach them.
+	TSet<uint64> CancelledIdentifiers;
+
+	FAdaDeferredWorkStats Stats;
+
+	double TotalLatencyMS = 0.0;
+	uint64 TotalLatencySteps = 0;
+
+	std::atomic<uint64> LatestIdentifier = 0;
+};
@@ -0,0 +1,98 @@
+// Copyright Matt Bramah-Taylor, 2025. All Rights Reserved.
+
+#pragma once
+
+#include <atomic>
+
+#include "HAL/CriticalSection.h"
+#include "HAL/Runnable.h"
+
+class FEvent;
+class FRunnableThread;
+class UAdaTickManager;
+
+// Thread that runs the tick manager's fixed steps at a fixed rate, independently of the game thread.
+class ADAGAMEPLAY_API FAdaSimulationThread : public FRunnable
+{
+public:
+	FAdaSimulationThread(UAdaTickManager* const InTickManager, const double InFixedStepSeconds, const uint8 InMaxCarriedSteps);
+	virtual ~FAdaSimulationThread() override;
+
+	// Create the underlying thread and start running fixed steps.
+	bool Start();
+
+	// Stop running fixed steps and wait for the thread to exit.
+	void Shutdown();
+
+	inline void SetPaused(const bool bInPaused) { bPaused = bInPaused; };
+
+	inline uint64 GetDroppedStepCount() const { return DroppedStepCount; };
+
+	// How long until the next step is due to start. Safe to call from any thread.
+	float GetTimeUntilNextStepMS() const;
+
+	//~ Begin FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	//~ End FRunnable interface
+
+private:
+	UAdaTickManager* TickManager = nullptr;
+
+	FRunnableThread* Thread = nullptr;
+
+	// Used to sleep until the next step is due, and to wake the thread early when stopping.
+	FEvent* WakeEvent = nullptr;
+
+	double FixedStepSeconds = 1.0 / 30.0;
+	uint8 MaxCarriedSteps = 0;
+
+	std::atomic<bool> bStopping = false;
+	std::atomic<bool> bPaused = false;
+	std::atomic<uint64> DroppedStepCount = 0;
+
+	// When the next step is due, in platform seconds.
+	std::atomic<double> NextStepSeconds = 0.0;
+};
+
+// Hands the latest state published by the simulation thread over to the game thread.
+// Uses three buffers rather than two, so that neither side ever has to wait for the other to finish with a buffer.
+template<typename T>
+class TAdaSimulationSnapshot
+{
+public:
+	// Simulation side: fill this in, then call Publish.
+	T& GetWriteBuffer() { return Buffers[WriteIndex]; };
+
+	// Simulation side: make the write buffer the latest snapshot.
+	void Publish()
+	{
+		FScopeLock Lock(&CriticalSection);
+		Swap(WriteIndex, PendingIndex);
+		bHasPending = true;
+	}
+
+	// Game thread side: get the latest published snapshot.
+	const T& Read()
+	{
+		FScopeLock Lock(&CriticalSection);
+		if (bHasPending)
+		{
+			Swap(ReadIndex, PendingIndex);
+			bHasPending = false;
+		}
+
+		return Buffers[ReadIndex];
+	}
+
+private:
+	T Buffers[3];
+
+	int32 WriteIndex = 0;
+	int32 PendingIndex = 1;
+	int32 ReadIndex = 2;
+
+	bool bHasPending = false;
+
+	FCriticalSection CriticalSection;
+};
@@ -0,0 +1,232 @@
+// Copyright Matt Bramah-Taylor, 2025. All Rights Reserved.
+
+#pragma once
+
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+// Type-erased interface to a batch of objects that share a single fixed step tick function.
+class ADAGAMEPLAY_API FAdaTickBatchBase
+{
+public:
+	FAdaTickBatchBase(const UClass* const InClass)
+		: DebugName(FString::Printf(TEXT("Batch:%s"), *GetNameSafe(InClass)))
+		, ClassName(InClass != nullptr ? InClass->GetFName() : NAME_None) {};
+
+	virtual ~FAdaTickBatchBase() = default;
+
+	// Call the batch function once with every live instance in the batch. Instances that have been marked for destruction are dropped first.
+	virtual void Execute(const uint64 Frame) = 0;
+
+	// Add an instance to the batch. If deferred, the instance won't be added until the next call to FlushPendingChanges.
+	virtual bool Add(UObject* const Object, const bool bDefer) = 0;
+
+	// Remove an instance from the batch. If deferred, the instance will keep being ticked until the next call to FlushPendingChanges.
+	virtual bool Remove(const UObject* const Object, const bool bDefer) = 0;
+
+	virtual bool Contains(const UObject* const Object) const = 0;
+
+	// Apply any additions and removals that were deferred while the batch was executing.
+	virtual void FlushPendingChanges() = 0;
+
+	// Drop any instances that have been destroyed without being removed from the batch.
+	virtual void ValidateInstances() = 0;
+
+	virtual int32 Num() const = 0;
+
+	// Name used for trace scopes.
+	const FString DebugName;
+
+	// Name of the batched class, used for CSV stats.
+	const FName ClassName;
+};
+
+// A batch of objects of type T that are ticked together by a single static function, rather than through a function wrapper each.
+// Instances are held contiguously; removed instances leave a hole which is compacted away the next time the batch executes.
+template<typename T>
+class TAdaTickBatch final : public FAdaTickBatchBase
+{
+	static_assert(TIsDerivedFrom<T, UObject>::Value);
+
+public:
+	using FBatchFunction = void(*)(TArrayView<T* const>, const uint64&);
+
+	TAdaTickBatch(FBatchFunction InBatchFunction)
+		: FAdaTickBatchBase(T::StaticClass())
+		, BatchFunction(InBatchFunction) {};
+
+	inline FBatchFunction GetBatchFunction() const { return BatchFunction; };
+
+	virtual void Execute(const uint64 Frame) override
+	{
+		// Anything destroyed since the last GC is still in memory, but mustn't be handed to the batch function.
+		for (int32 Index = 0; Index < Instances.Num(); Index++)
+		{
+			if (Instances[Index] != nullptr && !IsValid(Instances[Index]))
+			{
+				InstanceIndices.Remove(InstanceKeys[Index]);
+				RemoveAt(Index);
+			}
+		}
+
+		if (HoleCount > 0)
+		{
+			Compact();
+		}
+
+		if (!Instances.IsEmpty())
+		{
+			// Anything added or removed by the batch function itself has to wait, as we're handing out a view of the instance array.
+			TGuardValue<bool> ExecutingGuard(bIsExecuting, true);
+			BatchFunction(Instances, Frame);
+		}
+	}
+
+	virtual bool Add(UObject* const Object, const bool bDefer) override
+	{
+		T* const Instance = Cast<T>(Object);
+		if (Instance == nullptr || Contains(Instance))
+		{
+			return false;
+		}
+
+		if (bDefer || bIsExecuting)
+		{
+			PendingAdditions.Add(Instance);
+			return true;
+		}
+
+		const FObjectKey InstanceKey(Instance);
+		InstanceIndices.Add(InstanceKey, Instances.Add(Instance));
+		InstanceKeys.Add(InstanceKey);
+		return true;
+	}
+
+	virtual bool Remove(const UObject* const Object, const bool bDefer) override
+	{
+		const int32 PendingIndex = PendingAdditions.IndexOfByPredicate([Object](const TWeakObjectPtr<T>& Instance) { return Instance.Get(true) == Object; });
+		if (PendingIndex != INDEX_NONE)
+		{
+			PendingAdditions.RemoveAtSwap(PendingIndex, EAllowShrinking::No);
+			return true;
+		}
+
+		const FObjectKey InstanceKey(Object);
+		if (!InstanceIndices.Contains(InstanceKey) || PendingRemovals.Contains(InstanceKey))
+		{
+			return false;
+		}
+
+		if (bDefer || bIsExecuting)
+		{
+			PendingRemovals.Add(InstanceKey);
+		}
+		else
+		{
+			RemoveAt(InstanceIndices.FindAndRemoveChecked(InstanceKey));
+		}
+
+		return true;
+	}
+
+	virtual bool Contains(const UObject* const Object) const override
+	{
+		const FObjectKey InstanceKey(Object);
+		return (InstanceIndices.Contains(InstanceKey) && !PendingRemovals.Contains(InstanceKey))
+			|| PendingAdditions.ContainsByPredicate([Object](const TWeakObjectPtr<T>& Instance) { return Instance.Get(true) == Object; });
+	}
+
+	virtual void FlushPendingChanges() override
+	{
+		for (const FObjectKey& InstanceKey : PendingRemovals)
+		{
+			int32 Index = INDEX_NONE;
+			if (InstanceIndices.RemoveAndCopyValue(InstanceKey, Index))
+			{
+				RemoveAt(Index);
+			}
+		}
+
+		PendingRemovals.Reset();
+
+		for (const TWeakObjectPtr<T>& Instance : PendingAdditions)
+		{
+			if (IsValid(Instance.Get()))
+			{
+				Add(Instance.Get(), false);
+			}
+		}
+
+		PendingAdditions.Reset();
+	}
+
+	virtual void ValidateInstances() override
+	{
+		for (int32 Index = 0; Index < Instances.Num(); Index++)
+		{
+			if (Instances[Index] != nullptr && !IsValid(InstanceKeys[Index].ResolveObjectPtr()))
+			{
+				InstanceIndices.Remove(InstanceKeys[Index]);
+				RemoveAt(Index);
+			}
+		}
+
+		PendingAdditions.RemoveAllSwap([](const TWeakObjectPtr<T>& Instance) { return !IsValid(Instance.Get()); }, EAllowShrinking::No);
+	}
+
+	virtual int32 Num() const override
+	{
+		return Instances.Num() - HoleCount + PendingAdditions.Num();
+	}
+
+private:
+	void RemoveAt(const int32 Index)
+	{
+		Instances[Index] = nullptr;
+		InstanceKeys[Index] = FObjectKey();
+		HoleCount++;
+	}
+
+	void Compact()
+	{
+		int32 WriteIndex = 0;
+		for (int32 ReadIndex = 0; ReadIndex < Instances.Num(); ReadIndex++)
+		{
+			if (Instances[ReadIndex] == nullptr)
+			{
+				continue;
+			}
+
+			if (WriteIndex != ReadIndex)
+			{
+				Instances[WriteIndex] = Instances[ReadIndex];
+				InstanceKeys[WriteIndex] = InstanceKeys[ReadIndex];
+				InstanceIndices[InstanceKeys[WriteIndex]] = WriteIndex;
+			}
+
+			WriteIndex++;
+		}
+
+		Instances.SetNum(WriteIndex, EAllowShrinking::No);
+		InstanceKeys.SetNum(WriteIndex, EAllowShrinking::No);
+		HoleCount = 0;
+	}
+
+	FBatchFunction BatchFunction = nullptr;
+
+	// Live instances, passed directly to the batch function. Removals leave nulls here, which are compacted away before the next call.
+	TArray<T*> Instances;
+
+	// Keys for each entry in Instances, used to detect instances that were destroyed without being removed.
+	TArray<FObjectKey> InstanceKeys;
+
+	TMap<FObjectKey, int32> InstanceIndices;
+
+	// Held weakly, as these can be destroyed before they're ever added.
+	TArray<TWeakObjectPtr<T>> PendingAdditions;
+	TArray<FObjectKey> PendingRemovals;
+
+	int32 HoleCount = 0;
+
+	bool bIsExecuting = false;
+};
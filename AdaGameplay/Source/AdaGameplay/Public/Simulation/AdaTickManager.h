@@ -2,26 +2,123 @@
 
 #pragma once
 
+#include <atomic>
+
+#include "Containers/Queue.h"
+#include "Misc/Optional.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "Tasks/Task.h"
+#include "UObject/ObjectKey.h"
+#include "Simulation/AdaDeferredWorkQueue.h"
+#include "Simulation/AdaSimulationThread.h"
+#include "Simulation/AdaTickBatch.h"
+#include "Simulation/AdaTickManagerSettings.h"
+#include "Simulation/AdaTickManagerTypes.h"
 
 #include "AdaTickManager.generated.h"
 
+DECLARE_LOG_CATEGORY_EXTERN(LogAdaTickManager, Log, All);
+
 UCLASS(Config = Game)
 class ADAGAMEPLAY_API UAdaTickManager : public UWorldSubsystem
 {
 	GENERATED_BODY()
 
+	friend struct FAdaFixedStepTickFunction;
+	friend class FAdaSimulationThread;
+
 public:
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/// @brief	Register a function to be called on fixed steps.
+	/// @param	Object			The object that owns this tick function. Each object can only register a single tick function.
+	/// @param	TickFunction	The function to call.
+	/// @param	Params			Parameters describing how and when the tick function should run.
+	/// @return A handle to the registered tick function. Will be invalid if the object is already registered.
+	/// @note	Registrations made during a fixed step are deferred until the end of that step. When running a simulation thread, all
+	///			registrations and removals are deferred until the next step boundary.
+	FAdaTickFunctionHandle RegisterTickFunction(const UObject* const Object, const TFunction<void(const uint64&)>& TickFunction, const FAdaTickFunctionParams& Params = FAdaTickFunctionParams());
 
-	void RegisterTickFunction(const UObject* const Object, const TFunction<void(const uint64&)>& TickFunction);
+	/// @brief	Register a function to be called on fixed steps, which can advance several steps in a single call.
+	///			When the tick manager runs multiple steps at once, e.g. when collapsing leftover steps, regular tick functions are
+	///			called once per step, whereas multi-step tick functions are called once with the number of steps to advance by.
+	/// @param	Object			The object that owns this tick function. Each object can only register a single tick function.
+	/// @param	TickFunction	The function to call, with the latest frame and the number of steps since this tick function last ran.
+	/// @param	Params			Parameters describing how and when the tick function should run.
+	/// @return A handle to the registered tick function. Will be invalid if the object is already registered.
+	FAdaTickFunctionHandle RegisterMultiStepTickFunction(const UObject* const Object, const TFunction<void(const uint64&, const uint32)>& TickFunction, const FAdaTickFunctionParams& Params = FAdaTickFunctionParams());
+
+	/// @brief	Unregister the tick function owned by the given object.
+	/// @note	Removals made during a fixed step stop the tick function from running for the rest of the step, but are applied at the end of it.
 	void UnregisterTickFunction(const UObject* const Object);
 
-	inline uint64 GetCurrentFrame() const { return CurrentFrame; };
+	/// @brief	Unregister the tick function for the given handle, invalidating the handle.
+	void UnregisterTickFunction(FAdaTickFunctionHandle& Handle);
+
+	/// @brief	Check whether the given handle refers to a live or pending tick function.
+	bool IsTickFunctionRegistered(const FAdaTickFunctionHandle& Handle) const;
+
+	inline uint64 GetCurrentFrame() const { return CurrentFrame.load(std::memory_order_relaxed); };
+
+	/// @brief	How much engine frame time has to pass before the next fixed step is due.
+	float GetTimeUntilNextStepMS() const;
+
+	/// @brief	Gather cost figures for every registered tick function over the rolling cost window.
+	/// @param	OutReports	Array to fill with reports, sorted from most to least expensive by p95.
+	void GetTickFunctionCosts(TArray<FAdaTickFunctionCostReport>& OutReports) const;
+
+	/// @brief	Log the most expensive tick functions over the rolling cost window.
+	/// @param	Count	The maximum number of tick functions to log.
+	void DumpTickFunctionCosts(const int32 Count) const;
+
+	// Total number of fixed steps that were due but discarded, either by policy or because we were already carrying too many.
+	inline uint64 GetDroppedStepCount() const { return DroppedStepCount + (SimulationThread.IsValid() ? SimulationThread->GetDroppedStepCount() : 0); };
+
+	// Total number of times a due fixed step was pushed back to a later engine frame.
+	inline uint64 GetDeferredStepCount() const { return DeferredStepCount; };
+
+	// Total number of leftover fixed steps that were run as part of a single collapsed step.
+	inline uint64 GetCollapsedStepCount() const { return CollapsedStepCount; };
+
+	/// @brief	Remove an object from the tick batch for its class.
+	/// @param	BatchClass	The class the object was batched under, i.e. the T it was registered with.
+	void UnregisterBatchedTickFunction(const UObject* const Object, const UClass* const BatchClass);
+
+	/// @brief	Make fixed steps wait for the given engine tick function every frame.
+	/// @note	Only has an effect when fixed steps are run from the engine tick function.
+	void AddFixedStepPrerequisite(UObject* TargetObject, FTickFunction& TargetTickFunction);
+	void RemoveFixedStepPrerequisite(UObject* TargetObject, FTickFunction& TargetTickFunction);
+
+	/// @brief	Get the engine tick function that runs fixed steps, so that other tick functions can depend on it.
+	/// @return	The tick function, or nullptr if fixed steps aren't run from the engine tick function.
+	FTickFunction* GetFixedStepTickFunction();
+
+	/// @brief	Queue a command to be run at the start of the next fixed step, on whichever thread runs fixed steps.
+	///			This is how the game thread should hand data to simulation thread safe tick functions.
+	void EnqueueSimulationCommand(TUniqueFunction<void()>&& Command);
+
+	/// @brief	Queue a callback to be run on the game thread at the next game thread handoff.
+	///			This is how simulation thread safe tick functions should hand results back to the game thread.
+	void EnqueueGameThreadCallback(TUniqueFunction<void()>&& Callback);
+
+	inline bool IsUsingSimulationThread() const { return SimulationThread.IsValid(); };
+
+	/// @brief	Submit non-urgent work to be run at the end of fixed steps, within the deferred work budget.
+	/// @param	Work		Resumable work to run. Should check the context and return false if it needs to yield before it's finished.
+	/// @param	Priority	Higher priority work is always run before lower priority work.
+	/// @param	Owner		Optional object that owns this work. The work will be discarded if the owner is destroyed.
+	/// @return	A handle that can be used to cancel the work.
+	FAdaDeferredWorkHandle SubmitDeferredWork(FAdaDeferredWork&& Work, const EAdaDeferredWorkPriority Priority = EAdaDeferredWorkPriority::Normal, const UObject* const Owner = nullptr);
+
+	/// @brief	Cancel previously submitted deferred work, invalidating the handle.
+	void CancelDeferredWork(FAdaDeferredWorkHandle& Handle);
+
+	inline const FAdaDeferredWorkStats& GetDeferredWorkStats() const { return DeferredWorkQueue.GetStats(); };
 
 	template<typename T>
-	void RegisterTickFunction(T* Object, void(T::*TickFunction)(const uint64&))
+	FAdaTickFunctionHandle RegisterTickFunction(T* Object, void(T::*TickFunction)(const uint64&), const FAdaTickFunctionParams& Params = FAdaTickFunctionParams())
 	{
 		static_assert(TIsDerivedFrom<T, UObject>::Value);
 
@@ -34,27 +131,305 @@ public:
 			}
 		};
 		
-		RegisterTickFunction(Object, MoveTemp(FunctionWrapper));
+		return RegisterTickFunction(Object, MoveTemp(FunctionWrapper), Params);
 	}
 
-protected:
-	void OnWorldPreActorTick(UWorld* InWorld, ELevelTick InLevelTick, float InDeltaSeconds);
+	template<typename T>
+	FAdaTickFunctionHandle RegisterTickFunction(T* Object, void(T::*TickFunction)(const uint64&, const uint32), const FAdaTickFunctionParams& Params = FAdaTickFunctionParams())
+	{
+		static_assert(TIsDerivedFrom<T, UObject>::Value);
+
+		TWeakObjectPtr<T> WeakObject(Object);
+		TFunction<void(const uint64&, const uint32)> FunctionWrapper = [WeakObject, TickFunction](const uint64& CurrentFrame, const uint32 StepCount)
+		{
+			if (T* StrongObject = WeakObject.Get())
+			{
+				(StrongObject->*TickFunction)(CurrentFrame, StepCount);
+			}
+		};
+
+		return RegisterMultiStepTickFunction(Object, MoveTemp(FunctionWrapper), Params);
+	}
+
+	/// @brief	Register an object into the tick batch for its class.
+	///			All objects batched under T are ticked together by a single call to BatchFunction, with a contiguous array of instances,
+	///			which avoids the per-object function wrapper and weak pointer resolve of regular tick functions.
+	/// @param	Object			The object to add to the batch.
+	/// @param	BatchFunction	Static function that ticks every instance in the batch. Must be the same for every object batched under T.
+	/// @return	Whether the object was added to the batch.
+	/// @note	Batches run every step, after all regular tick functions that aren't worker thread safe, on the thread running fixed steps.
+	///			That's the game thread unless fixed steps are run from an engine tick function that can run on any thread.
+	///			When running a simulation thread, batches belong to the game thread instead, so are run on it, and can only be registered from it.
+	///			Objects must unregister before they're destroyed; any that don't are skipped, and cleaned up after the next garbage collection.
+	template<typename T>
+	bool RegisterBatchedTickFunction(T* Object, void(*BatchFunction)(TArrayView<T* const>, const uint64&))
+	{
+		static_assert(TIsDerivedFrom<T, UObject>::Value);
+
+		if (!CanRegisterBatchedTickFunction(Object) || BatchFunction == nullptr)
+		{
+			return false;
+		}
+
+		// Batches are only touched from the game thread when there's a simulation thread, so there's no step to lock out.
+		TOptional<FScopeLock> Lock;
+		if (!SimulationThread.IsValid())
+		{
+			Lock.Emplace(&RegistrationCriticalSection);
+		}
+
+		TUniquePtr<FAdaTickBatchBase>& Batch = TickBatches.FindOrAdd(T::StaticClass());
+		if (!Batch.IsValid())
+		{
+			Batch = MakeUnique<TAdaTickBatch<T>>(BatchFunction);
+		}
+		else if (!ensureMsgf(static_cast<TAdaTickBatch<T>*>(Batch.Get())->GetBatchFunction() == BatchFunction, TEXT("%hs: Objects batched under %s must all use the same batch function."), __FUNCTION__, *T::StaticClass()->GetName()))
+		{
+			return false;
+		}
+
+		return Batch->Add(Object, ShouldDeferBatchChanges());
+	}
+
+	template<typename T>
+	void UnregisterBatchedTickFunction(const T* Object)
+	{
+		UnregisterBatchedTickFunction(Object, T::StaticClass());
+	}
 
 private:
-	struct FTickFunction
+	struct FAdaRegisteredTickFunction
 	{
 		TWeakObjectPtr<const UObject> ObjectToTick;
-		TFunction<void(const uint64&)> TickFunction;
+		TFunction<void(const uint64&, const uint32)> TickFunction;
+
+		// Whether the tick function wants a single call per fixed step run, rather than one per frame it was due on.
+		bool bMultiStep = false;
+
+		// The last frame this tick function was run for.
+		uint64 LastRunFrame = 0;
+
+		// Cached key for the owning object, which stays usable after the object has been destroyed.
+		FObjectKey ObjectKey;
+
+		// This tick function runs on fixed steps where CurrentFrame % RateDivisor == Phase.
+		uint16 RateDivisor = 1;
+		uint16 Phase = 0;
+
+		bool bWorkerThreadSafe = false;
+		bool bSimulationThreadSafe = false;
+
+		TArray<TWeakObjectPtr<const UObject>> Prerequisites;
+
+		// Name used for trace scopes and cost reports.
+		FString DebugName;
+
+		// Name of the owning object's class, used for CSV stats so that they stay bounded in number.
+		FName ClassName;
+
+		// Ring buffer of recent costs, in milliseconds.
+		TArray<float> CostSamplesMS;
+		int32 NextCostSample = 0;
+
+		double LastBudgetWarningSeconds = 0.0;
+
+		// Incremented each time this slot is allocated, so handles to previous occupants are rejected.
+		uint32 Generation = 0;
+
+		// Whether this slot currently holds a registered tick function.
+		bool bActive = false;
+
+		// Whether this tick function was unregistered during the current step and should no longer run.
+		bool bPendingRemoval = false;
+	};
+
+	// The frames a tick function is due on within a single, possibly multi-step, fixed step.
+	struct FDueSteps
+	{
+		// The latest frame the tick function is due on.
+		uint64 LastFrame = 0;
+
+		// How many frames in the step the tick function is due on.
+		uint32 Count = 0;
+
+		// How many frames have passed since the tick function last ran.
+		uint32 ElapsedSteps = 0;
 	};
-	
+
+	// A registration made during a step, waiting to be moved into its reserved slot.
+	struct FPendingTickFunction
+	{
+		int32 Index = INDEX_NONE;
+		uint32 Generation = 0;
+		FAdaRegisteredTickFunction TickFunction;
+		bool bCancelled = false;
+	};
+
+protected:
+	void OnWorldPreActorTick(UWorld* InWorld, ELevelTick InLevelTick, float InDeltaSeconds);
+
+	// Accumulate engine frame time and run any fixed steps that are due.
+	void AdvanceFixedSteps(const float DeltaSeconds);
+
+	// Run a single fixed step from the simulation thread.
+	void RunSimulationThreadStep();
+
+	// Apply any commands queued for the next fixed step.
+	void ProcessSimulationCommands();
+
+	// Run any callbacks queued for the game thread.
+	void ProcessGameThreadCallbacks();
+
+	// Whether the calling thread may register and unregister tick functions: the game thread, or the thread currently running fixed steps.
+	bool CanModifyRegistrations() const;
+
+	FAdaTickFunctionHandle RegisterTickFunction_Internal(const UObject* const Object, TFunction<void(const uint64&, const uint32)>&& TickFunction, const bool bMultiStep, const FAdaTickFunctionParams& Params);
+
+	// Run a fixed step for all registered tick functions, advancing the simulation by the given number of frames.
+	// Multi-step tick functions are called once for the whole step, and everything else once per frame it was due on.
+	void RunFixedStep(const uint32 StepCount = 1);
+
+	// Work out which frames of the step ending on CurrentFrame the tick function is due on.
+	bool GetDueSteps(const FAdaRegisteredTickFunction& TickFunction, const uint32 StepCount, FDueSteps& OutDueSteps) const;
+
+	// Call the tick function, recording how long it took.
+	// Safe to call from worker threads as long as no other thread is running the same tick function.
+	void InvokeTickFunction(FAdaRegisteredTickFunction& TickFunction, const FDueSteps& DueSteps) const;
+
+	static void DispatchTickFunction(const TFunction<void(const uint64&, const uint32)>& Function, const bool bMultiStep, const uint16 RateDivisor, const FDueSteps& DueSteps);
+
+	// Free the given slot immediately, or at the end of the step if we're currently ticking.
+	void RemoveSlot(const int32 Index);
+
+	// Apply any registrations and removals that were deferred to the step boundary.
+	void FlushPendingChanges();
+
+	// Move a tick function into its slot and make it active.
+	void ActivateSlot(const int32 Index, const uint32 Generation, FAdaRegisteredTickFunction&& TickFunction);
+	void ReleaseSlot(const int32 Index);
+
+	// Rebuild the execution order of tick functions from their prerequisites.
+	void RebuildExecutionOrder();
+
+	// Pick the least loaded phase for a tick function running at the given rate divisor.
+	uint16 AssignPhase(const uint16 RateDivisor);
+	void ReleasePhase(const uint16 RateDivisor, const uint16 Phase);
+
+	// Apply the overrun policy to any whole steps left in the accumulator at the end of an engine frame.
+	void HandleLeftoverSteps();
+
+	// Run every tick batch once for each frame of the step, handing them to the game thread if there's a simulation thread.
+	void RunTickBatches(const uint32 StepCount);
+
+	// Run every tick batch for each of the given frames. Must be called from the game thread when there's a simulation thread.
+	void ExecuteTickBatches(const uint64 FirstFrame, const uint64 LastFrame);
+
+	bool CanRegisterBatchedTickFunction(const UObject* const Object) const;
+
+	// Whether registrations and removals have to wait for the next step boundary. They always do when there's a simulation thread,
+	// so that the game thread never has to wait on a step in progress.
+	inline bool ShouldDeferRegistrationChanges() const { return SimulationThread.IsValid() || bIsTicking; };
+
+	// Whether batch changes have to wait for the end of the step. Batches are run from game thread callbacks when there's a simulation
+	// thread, and those never overlap with changes, so the batches' own guards are enough.
+	inline bool ShouldDeferBatchChanges() const { return !SimulationThread.IsValid() && bIsTicking; };
+
+	// Run deferred work within its budget for the current step.
+	void DrainDeferredWork();
+
+	// Drop batched objects that were destroyed without unregistering.
+	void OnPostGarbageCollect();
+
+private:
 	FDelegateHandle PreWorldActorTickHandle;
+	FDelegateHandle PostGarbageCollectHandle;
+
+	FAdaFixedStepTickFunction FixedStepTickFunction;
+
+	// Guards registrations against fixed steps running on another thread from the engine tick function.
+	// The simulation thread only takes it at step boundaries, or to change registrations itself.
+	mutable FCriticalSection RegistrationCriticalSection;
+
+	// Held by the simulation thread for the whole of each step, for the few readers that need to wait for one to finish.
+	mutable FCriticalSection StepCriticalSection;
+
+	TUniquePtr<FAdaSimulationThread> SimulationThread;
+
+	// Handoff queues between the game thread and the thread running fixed steps.
+	TQueue<TUniqueFunction<void()>, EQueueMode::Mpsc> SimulationCommands;
+	TQueue<TUniqueFunction<void()>, EQueueMode::Mpsc> GameThreadCallbacks;
+
+	// The thread currently running fixed steps, or 0 if none are running.
+	std::atomic<uint32> FixedStepThreadId = 0;
 
 	float FixedStepMS = 1000.0f / 30.0f;
 	float UnspentTimeMS = 0.0f;
 
-	uint64 CurrentFrame = 0;
+	// UnspentTimeMS as of the end of the last call to AdvanceFixedSteps, for the game thread to read while steps run elsewhere.
+	std::atomic<float> PublishedUnspentTimeMS = 0.0f;
+
+	// Time owed to the simulation when stretching leftover steps over later frames.
+	float CatchUpDebtMS = 0.0f;
+
+	float FrameBudgetMS = 0.0f;
+	float SubscriberBudgetMS = 0.0f;
+	float BudgetWarningIntervalSeconds = 0.0f;
+	float DeferredWorkBudgetMS = 0.0f;
+
+	int32 CostWindowSize = 64;
+
+	// Only written by the thread running fixed steps, but read from any.
+	std::atomic<uint64> CurrentFrame = 0;
+
+	uint64 DroppedStepCount = 0;
+	uint64 DeferredStepCount = 0;
+	uint64 CollapsedStepCount = 0;
+
+	EAdaTickOverrunPolicy OverrunPolicy = EAdaTickOverrunPolicy::Carry;
+	uint8 MaxStepsPerFrame = 1;
+	uint8 MaxCarriedSteps = 0;
 
 	bool bUseAggregatedTicks = false;
+	bool bAllowParallelTicks = true;
+	bool bUseEngineTickFunction = false;
+	bool bUseSimulationThread = false;
+	bool bSimulationThreadDedicatedServerOnly = true;
+
+	// Slot array of tick functions. Inactive slots are tracked in FreeSlots and reused by later registrations.
+	TArray<FAdaRegisteredTickFunction> TickFunctions;
+	TArray<int32> FreeSlots;
+
+	// Handle lookup for each object with a live or pending tick function.
+	TMap<FObjectKey, FAdaTickFunctionHandle> ObjectToHandle;
+
+	// Changes made while a step is running, applied at the end of the step.
+	TArray<FPendingTickFunction> PendingAdditions;
+	TArray<int32> PendingRemovals;
+
+	// Number of slots past the end of TickFunctions that have been handed out to pending additions.
+	int32 ReservedSlotCount = 0;
+
+	// Number of active tick functions that name prerequisites. When zero, we can skip the execution order entirely.
+	int32 PrerequisiteUserCount = 0;
+
+	// Indices into TickFunctions, sorted such that every tick function comes after its prerequisites.
+	TArray<int32> ExecutionOrder;
+
+	// Resolved prerequisite indices for each entry in TickFunctions.
+	TArray<TArray<int32>> PrerequisiteIndices;
+
+	// Tasks launched for worker thread safe tick functions during the current step, indexed the same as TickFunctions.
+	TArray<UE::Tasks::FTask> StepTasks;
+
+	bool bExecutionOrderDirty = false;
+	bool bIsTicking = false;
+
+	// Number of tick functions assigned to each phase, keyed by rate divisor.
+	TMap<uint16, TArray<int32>> PhaseLoads;
+
+	// Drained on the game thread when there's a simulation thread, with anything submitted from the simulation thread handed over to it.
+	FAdaDeferredWorkQueue DeferredWorkQueue;
 
-	TArray<FTickFunction> TickFunctions;
+	// Tick batches, keyed by the class their instances were batched under.
+	TMap<const UClass*, TUniquePtr<FAdaTickBatchBase>> TickBatches;
 };
\ No newline at end of file
@@ -3,8 +3,19 @@
 #pragma once
 
 #include "Engine/DeveloperSettings.h"
+#include "Engine/EngineBaseTypes.h"
 #include "AdaTickManagerSettings.generated.h"
 
+// What the tick manager should do with whole fixed steps that it wasn't able to run within a single engine frame.
+UENUM()
+enum class EAdaTickOverrunPolicy : uint8
+{
+	Drop		UMETA(Tooltip = "Discard any steps we couldn't run this frame. Simulation time will slip behind wall-clock time."),
+	Carry		UMETA(Tooltip = "Keep steps we couldn't run this frame and run them as soon as possible on subsequent frames."),
+	Stretch		UMETA(Tooltip = "Keep steps we couldn't run this frame and repay them at a rate of at most one extra step per engine frame."),
+	Collapse	UMETA(Tooltip = "Run steps we couldn't run this frame as a single multi-step step straight away. Multi-step tick functions catch up in one call.")
+};
+
 UCLASS(Config = Game, DefaultConfig)
 class ADAGAMEPLAY_API UAdaTickManagerSettings : public UDeveloperSettings
 {
@@ -18,7 +29,78 @@ public:
 	uint8 TargetTPS = 30;
 
 	/// Whether to use aggregated ticks or not.
-	/// @note: Currently unsupported.
+	/// When enabled, the tick manager will run multiple fixed steps in a single engine frame in order to catch up with wall-clock time.
 	UPROPERTY(Config, EditAnywhere, Category = "Tick Settings")
 	bool bUseAggregatedTicks = false;
+
+	/// The maximum number of fixed steps we'll run in a single engine frame when using aggregated ticks.
+	UPROPERTY(Config, EditAnywhere, Category = "Tick Settings", Meta = (EditCondition = "bUseAggregatedTicks", ClampMin = 1))
+	uint8 MaxStepsPerFrame = 4;
+
+	/// The wall-clock budget, in milliseconds, for running fixed steps in a single engine frame.
+	/// We'll always run at least one step if one is due, but won't start any further steps once this budget has been used up.
+	/// A value of 0 disables the budget.
+	UPROPERTY(Config, EditAnywhere, Category = "Tick Settings", Meta = (EditCondition = "bUseAggregatedTicks", ClampMin = 0.0, Units = "ms"))
+	float FrameBudgetMS = 0.0f;
+
+	/// Whether tick functions that declare themselves worker thread safe may run concurrently within a fixed step.
+	/// When disabled, all tick functions run serially on the game thread in dependency order.
+	UPROPERTY(Config, EditAnywhere, Category = "Tick Settings")
+	bool bAllowParallelTicks = true;
+
+	/// The number of recent fixed steps we keep cost samples for, per tick function.
+	UPROPERTY(Config, EditAnywhere, Category = "Profiling", Meta = (ClampMin = 1, ClampMax = 1024))
+	int32 CostWindowSize = 64;
+
+	/// The wall-clock budget, in milliseconds, for a single tick function on a single fixed step.
+	/// Tick functions that exceed this will log a warning. A value of 0 disables the warning.
+	UPROPERTY(Config, EditAnywhere, Category = "Profiling", Meta = (ClampMin = 0.0, Units = "ms"))
+	float SubscriberBudgetMS = 2.0f;
+
+	/// The minimum time between budget warnings for any one tick function.
+	UPROPERTY(Config, EditAnywhere, Category = "Profiling", Meta = (ClampMin = 0.0, Units = "s"))
+	float BudgetWarningIntervalSeconds = 5.0f;
+
+	/// What to do with fixed steps that were due, but couldn't be run in the frame they were due.
+	UPROPERTY(Config, EditAnywhere, Category = "Tick Settings")
+	EAdaTickOverrunPolicy OverrunPolicy = EAdaTickOverrunPolicy::Carry;
+
+	/// The maximum number of fixed steps we'll hold on to when carrying, stretching or collapsing leftover time.
+	/// Anything beyond this is dropped, which prevents the simulation from spiralling when under sustained load.
+	UPROPERTY(Config, EditAnywhere, Category = "Tick Settings", Meta = (EditCondition = "OverrunPolicy!=EAdaTickOverrunPolicy::Drop"))
+	uint8 MaxCarriedSteps = 8;
+
+	/// Whether to run fixed steps from an engine tick function, rather than from a hook that runs before all actor ticks.
+	/// This lets fixed steps take part in the engine's tick task graph, with a configurable tick group and prerequisites.
+	UPROPERTY(Config, EditAnywhere, Category = "Engine Integration")
+	bool bUseEngineTickFunction = false;
+
+	/// The tick group that fixed steps start in when using the engine tick function.
+	UPROPERTY(Config, EditAnywhere, Category = "Engine Integration", Meta = (EditCondition = "bUseEngineTickFunction"))
+	TEnumAsByte<ETickingGroup> TickGroup = TG_PrePhysics;
+
+	/// The tick group that fixed steps must finish by when using the engine tick function.
+	/// Setting this later than TickGroup lets fixed steps overlap with the tick groups in between.
+	UPROPERTY(Config, EditAnywhere, Category = "Engine Integration", Meta = (EditCondition = "bUseEngineTickFunction"))
+	TEnumAsByte<ETickingGroup> EndTickGroup = TG_PrePhysics;
+
+	/// Whether the engine tick function may run fixed steps on a worker thread.
+	/// Tick functions that aren't worker thread safe will then run on that worker thread too, serially, so this should only be
+	/// enabled when every game thread tick function is happy to run off the game thread as long as nothing else is ticking it.
+	UPROPERTY(Config, EditAnywhere, Category = "Engine Integration", Meta = (EditCondition = "bUseEngineTickFunction"))
+	bool bRunTickFunctionOnAnyThread = false;
+
+	/// Whether to run fixed steps on a dedicated simulation thread at TargetTPS, rather than on the game thread.
+	/// Takes precedence over the engine tick function. Tick functions must declare that they're simulation thread safe to run on it.
+	UPROPERTY(Config, EditAnywhere, Category = "Simulation Thread")
+	bool bUseSimulationThread = false;
+
+	/// Whether to only use the simulation thread on dedicated servers.
+	UPROPERTY(Config, EditAnywhere, Category = "Simulation Thread", Meta = (EditCondition = "bUseSimulationThread"))
+	bool bSimulationThreadDedicatedServerOnly = true;
+
+	/// The wall-clock budget, in milliseconds, for running deferred work at the end of each fixed step.
+	/// We'll always run at least one work item per step if any are queued; anything that doesn't fit within the budget is carried over to later steps.
+	UPROPERTY(Config, EditAnywhere, Category = "Deferred Work", Meta = (ClampMin = 0.0, Units = "ms"))
+	float DeferredWorkBudgetMS = 1.0f;
 };
@@ -0,0 +1,105 @@
+// Copyright Matt Bramah-Taylor, 2025. All Rights Reserved.
+
+#pragma once
+
+#include "Engine/EngineBaseTypes.h"
+
+#include "AdaTickManagerTypes.generated.h"
+
+class UAdaTickManager;
+
+// Parameters describing how a tick function registered with the tick manager should be run.
+USTRUCT()
+struct ADAGAMEPLAY_API FAdaTickFunctionParams
+{
+	GENERATED_BODY()
+
+public:
+	FAdaTickFunctionParams() = default;
+	FAdaTickFunctionParams(const uint16 InRateDivisor) : RateDivisor(InRateDivisor) {};
+
+	// How often this tick function should run, in fixed steps. 1 runs every step, 2 every other step, and so on.
+	// Tick functions sharing a rate divisor are staggered across phases by the tick manager so that their cost is spread out.
+	uint16 RateDivisor = 1;
+
+	// Whether this tick function can safely run on a worker thread, concurrently with other tick functions.
+	// Tick functions that set this must not touch data owned by other tick functions that aren't listed as prerequisites.
+	bool bWorkerThreadSafe = false;
+
+	// Whether this tick function can run on the dedicated simulation thread, when the tick manager is using one.
+	// Tick functions that don't set this are handed back to the game thread, and run there at the next game thread handoff.
+	bool bSimulationThreadSafe = false;
+
+	// Objects whose tick functions must finish before this one runs on any fixed step where both are due.
+	TArray<TWeakObjectPtr<const UObject>> Prerequisites;
+};
+
+// Generational handle to a tick function registered with the tick manager.
+// Remains safe to hold after the tick function has been unregistered; the generation check will simply fail.
+USTRUCT()
+struct ADAGAMEPLAY_API FAdaTickFunctionHandle
+{
+	GENERATED_BODY()
+
+	friend class UAdaTickManager;
+
+public:
+	FAdaTickFunctionHandle() = default;
+
+	inline bool IsValid() const { return Index != INDEX_NONE; };
+	inline void Invalidate() { Index = INDEX_NONE; Generation = 0; };
+
+	inline bool operator==(const FAdaTickFunctionHandle& Other) const { return Index == Other.Index && Generation == Other.Generation; };
+	inline bool operator!=(const FAdaTickFunctionHandle& Other) const { return !(*this == Other); };
+
+private:
+	FAdaTickFunctionHandle(const int32 InIndex, const uint32 InGeneration) : Index(InIndex), Generation(InGeneration) {};
+
+	// The slot in the tick manager this tick function occupies.
+	int32 Index = INDEX_NONE;
+
+	// The generation of the slot at the time of registration. Used to reject stale handles after the slot has been reused.
+	uint32 Generation = 0;
+};
+
+// Summary of the wall time spent in a single tick function over the tick manager's rolling cost window.
+USTRUCT()
+struct ADAGAMEPLAY_API FAdaTickFunctionCostReport
+{
+	GENERATED_BODY()
+
+public:
+	FString ClassName;
+	FString ObjectName;
+
+	float MinMS = 0.0f;
+	float MeanMS = 0.0f;
+	float P95MS = 0.0f;
+	float MaxMS = 0.0f;
+
+	// How many samples these figures were calculated from.
+	int32 SampleCount = 0;
+};
+
+// Engine tick function that runs the tick manager's fixed steps from within the engine's tick task graph.
+USTRUCT()
+struct ADAGAMEPLAY_API FAdaFixedStepTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+public:
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+	virtual FName DiagnosticContext(bool bDetailed) override;
+
+	UAdaTickManager* Target = nullptr;
+};
+
+template<>
+struct TStructOpsTypeTraits<FAdaFixedStepTickFunction> : public TStructOpsTypeTraitsBase2<FAdaFixedStepTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};